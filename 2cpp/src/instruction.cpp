@@ -59,14 +59,14 @@ namespace laskin2cpp
     const struct options& options
   ) const
   {
-    writer.print("c.dictionary[" + writer::escape(id) + "] = ");
+    writer.print("c.define(" + writer::escape(id) + ", ");
     if (value)
     {
       laskin2cpp::transpile(*value, writer, options);
     } else {
       writer.print("c.pop()");
     }
-    writer.println(";");
+    writer.println(");");
   }
 
   void
@@ -286,6 +286,22 @@ namespace laskin2cpp
     }
     switch (node->type())
     {
+      case laskin::node::type::binding:
+      case laskin::node::type::closure:
+      case laskin::node::type::local:
+        throw laskin::error(
+          laskin::error::type::syntax,
+          U"Unable to transpile local variables.",
+          node->position
+        );
+
+      case laskin::node::type::compiled:
+        throw laskin::error(
+          laskin::error::type::syntax,
+          U"Unable to transpile optimized code.",
+          node->position
+        );
+
       case laskin::node::type::definition:
         throw laskin::error(
           laskin::error::type::syntax,
@@ -23,17 +23,26 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <cctype>
 #include <cstring>
 #include <fstream>
 
 #include <unistd.h>
 
+#include <peelo/unicode/encoding/utf8.hpp>
+
 #include "laskin/context.hpp"
+#include "laskin/effect.hpp"
 #include "laskin/error.hpp"
+#include "laskin/profiler.hpp"
 #include "laskin/quote.hpp"
 
 static std::string programfile;
 static std::vector<std::string> inline_scripts;
+static bool print_ngrams = false;
+static bool check_only = false;
+static enum laskin::numeric::mode numeric_mode = laskin::numeric::mode::mpfr;
+static long numeric_precision = 0;
 
 namespace laskin::cli
 {
@@ -41,7 +50,10 @@ namespace laskin::cli
 }
 
 static void parse_args(int, char**);
+static bool parse_numeric(const char*);
 static void print_usage(std::ostream&, const char*);
+static void print_profile(const laskin::context&);
+static laskin::quote parse_program();
 
 int
 main(int argc, char** argv)
@@ -50,9 +62,24 @@ main(int argc, char** argv)
 
   parse_args(argc, argv);
 
+  if (print_ngrams)
+  {
+    context.profiler = std::make_shared<laskin::profiler>();
+  }
+
+  context.numeric.set_mode(numeric_mode);
+
   try
   {
-    if (!inline_scripts.empty())
+    if (numeric_precision > 0)
+    {
+      laskin::numeric::set_precision(numeric_precision);
+    }
+    if (check_only)
+    {
+      laskin::effect::check(parse_program(), context);
+    }
+    else if (!inline_scripts.empty())
     {
       int line = 1;
 
@@ -74,6 +101,7 @@ main(int argc, char** argv)
   }
   catch (const laskin::error& error)
   {
+    print_profile(context);
     if (error.is(laskin::error::type::exit))
     {
       std::exit(EXIT_SUCCESS);
@@ -82,6 +110,7 @@ main(int argc, char** argv)
       std::exit(EXIT_FAILURE);
     }
   }
+  print_profile(context);
 
   return EXIT_SUCCESS;
 }
@@ -119,6 +148,26 @@ parse_args(int argc, char** argv)
       {
         std::cerr << "Laskin " << LASKIN_VERSION << std::endl;
         std::exit(EXIT_SUCCESS);
+      }
+      else if (!std::strcmp(arg, "--ngrams"))
+      {
+        print_ngrams = true;
+        continue;
+      }
+      else if (!std::strcmp(arg, "--check"))
+      {
+        check_only = true;
+        continue;
+      }
+      else if (!std::strncmp(arg, "--numeric=", 10))
+      {
+        if (!parse_numeric(arg + 10))
+        {
+          std::cerr << "Unrecognized numeric mode: " << arg + 10 << std::endl;
+          print_usage(std::cerr, argv[0]);
+          std::exit(EXIT_FAILURE);
+        }
+        continue;
       } else {
         std::cerr << "Unrecognized switch: " << arg << std::endl;
         print_usage(std::cerr, argv[0]);
@@ -171,9 +220,115 @@ print_usage(std::ostream& output, const char* executable_name)
          << std::endl
          << "  -e program        One line of program. (Omit programfile.)"
          << std::endl
+         << "  --check           Check the program for errors without"
+         << std::endl
+         << "                    running it."
+         << std::endl
+         << "  --numeric=MODE    Either `double' for IEEE doubles, or `mpfr' or"
+         << std::endl
+         << "                    `mpfr:BITS' for arbitrary precision numbers."
+         << std::endl
+         << "  --ngrams          Print the most frequently executed sequences of"
+         << std::endl
+         << "                    words after the program has finished."
+         << std::endl
          << "  --version         Print the version."
          << std::endl
          << "  --help            Display this message."
          << std::endl
          << std::endl;
 }
+
+/**
+ * Parses numeric mode given in the command line arguments, which is either
+ * `double', `mpfr' or `mpfr:' followed by precision in bits.
+ */
+static bool
+parse_numeric(const char* input)
+{
+  char* end;
+
+  if (!std::strcmp(input, "double"))
+  {
+    numeric_mode = laskin::numeric::mode::fast;
+
+    return true;
+  }
+  else if (std::strncmp(input, "mpfr", 4))
+  {
+    return false;
+  }
+  numeric_mode = laskin::numeric::mode::mpfr;
+  input += 4;
+  if (!*input)
+  {
+    return true;
+  }
+  else if (*input != ':' || !std::isdigit(input[1]))
+  {
+    return false;
+  }
+  numeric_precision = std::strtol(input + 1, &end, 10);
+
+  return !*end && numeric_precision > 0;
+}
+
+/**
+ * Prints the most frequently executed sequences of words into standard error
+ * stream, if the program was run with profiling enabled.
+ */
+static void
+print_profile(const laskin::context& context)
+{
+  using peelo::unicode::encoding::utf8::encode;
+
+  if (!context.profiler)
+  {
+    return;
+  }
+  for (const auto& entry : context.profiler->most_frequent(20))
+  {
+    std::cerr << entry.second << '\t' << encode(entry.first) << std::endl;
+  }
+}
+
+/**
+ * Parses the program given in the command line arguments, or read from the
+ * standard input stream, without executing it.
+ */
+static laskin::quote
+parse_program()
+{
+  using peelo::unicode::encoding::utf8::decode;
+
+  if (!inline_scripts.empty())
+  {
+    laskin::quote::node_container nodes;
+    int line = 1;
+
+    for (const auto& source : inline_scripts)
+    {
+      const auto script = laskin::quote::parse(source, "<arg>", line++).nodes();
+
+      nodes.insert(std::end(nodes), std::begin(script), std::end(script));
+    }
+
+    return laskin::quote(nodes);
+  }
+  else if (!programfile.empty())
+  {
+    std::ifstream input(programfile);
+
+    if (!input.good())
+    {
+      throw laskin::error(
+        laskin::error::type::system,
+        U"Unable to open file `" + decode(programfile) + U"' for reading."
+      );
+    }
+
+    return laskin::quote::parse(input, programfile);
+  }
+
+  return laskin::quote::parse(std::cin, "<stdin>");
+}
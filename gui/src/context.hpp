@@ -50,14 +50,9 @@ namespace laskin::gui
       return m_context.data;
     }
 
-    inline context::dictionary_type& dictionary()
-    {
-      return m_context.dictionary;
-    }
-
     inline const context::dictionary_type& dictionary() const
     {
-      return m_context.dictionary;
+      return m_context.dictionary();
     }
 
     void execute(const Glib::ustring& source_code, int line = 1);
@@ -25,7 +25,9 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "laskin/macros.hpp"
 #include "laskin/position.hpp"
@@ -35,6 +37,19 @@ namespace laskin
 {
   class context;
 
+  /**
+   * Lexical scope of local variables declared with `-> ( ... )` inside an
+   * quote. Names of the variables are resolved into slots of the scope when
+   * the quote is parsed, and each call of the quote gets an activation frame
+   * of it's own that holds the values of the slots.
+   */
+  class scope
+  {
+  public:
+    /** Names of the local variables, indexed by their slot. */
+    std::vector<std::u32string> names;
+  };
+
   /**
    * Representation of an AST node.
    */
@@ -43,15 +58,23 @@ namespace laskin
   public:
     enum class type
     {
+      binding,
+      closure,
+      compiled,
       definition,
       literal,
+      local,
       record_literal,
       symbol,
       vector_literal,
     };
 
+    class binding;
+    class closure;
+    class compiled;
     class definition;
     class literal;
+    class local;
     class record_literal;
     class symbol;
     class vector_literal;
@@ -99,9 +122,30 @@ namespace laskin
       const std::shared_ptr<node>& b
     )
     {
+      // Interned nodes are shared, so the same node is quite often compared
+      // with itself.
+      if (a == b)
+      {
+        return true;
+      }
+
       return a ? a->equals(b) : !b;
     }
 
+    /**
+     * Hash-consed key that identifies contents of an node. Two nodes with
+     * equal contents receive the same key, so that they can be compared by
+     * comparing the pointers only. Keys are shared between threads, but each
+     * thread caches the keys it has seen so that parsing seldom has to lock
+     * the shared table. Keys are released once no node refers to them.
+     */
+    using key_type = std::shared_ptr<const std::u32string>;
+
+    /**
+     * Returns the canonical key for given contents of an node.
+     */
+    static key_type intern_key(const std::u32string& contents);
+
     /**
      * Tests whether node is equal with another node.
      */
@@ -122,9 +166,7 @@ namespace laskin
     explicit literal(
       const class value& value_,
       const std::optional<struct position>& position_ = std::nullopt
-    )
-      : node(position_)
-      , value(value_) {}
+    );
 
     inline enum type type() const override
     {
@@ -150,6 +192,13 @@ namespace laskin
     {
       return value.to_source();
     }
+
+  private:
+    /**
+     * Hash-consed key of string and boolean literals, or null pointer for
+     * literals that have to be compared by their value.
+     */
+    const key_type m_key;
   };
 
   class node::vector_literal final : public node
@@ -226,6 +275,11 @@ namespace laskin
   class node::symbol final : public node
   {
   public:
+    /** Signature of builtin words, same as `quote::native`. */
+    using native = void(*)(class context&, std::ostream*);
+    /** Signature of specialized builtin words, same as `quicken::handler`. */
+    using handler = bool(*)(class context&);
+
     const std::u32string id;
 
     explicit symbol(
@@ -233,7 +287,23 @@ namespace laskin
       const std::optional<struct position>& position_ = std::nullopt
     )
       : node(position_)
-      , id(id_) {}
+      , id(id_)
+      , m_key(intern_key(id_))
+      , m_generation(0)
+      , m_bound(false)
+      , m_binding(nullptr)
+      , m_quickened(false)
+      , m_handler(nullptr)
+      , m_deoptimizations(0) {}
+
+    /**
+     * Returns symbol node without position for given identifier. Nodes are
+     * interned, so that every request for the same identifier receives the
+     * same node instead of an new allocation, and the node keeps it's
+     * resolved binding between uses. Nodes are interned per thread, as the
+     * binding cache is not safe to be shared between threads.
+     */
+    static std::shared_ptr<symbol> intern(const std::u32string& id);
 
     inline enum type type() const override
     {
@@ -256,6 +326,33 @@ namespace laskin
     {
       return id;
     }
+
+  private:
+    /**
+     * Resolves the word that the symbol is bound to in given context and
+     * caches it for as long as the dictionary of the context does not change.
+     */
+    void bind(const class context& context) const;
+
+  private:
+    /** Hash-consed identifier, interned when the symbol is parsed. */
+    const key_type m_key;
+    /** Dictionary generation in which the cached binding was resolved. */
+    mutable std::uint64_t m_generation;
+    /** Whether the binding has been resolved at all. */
+    mutable bool m_bound;
+    /** Type of topmost stack value required by the binding, if any. */
+    mutable std::optional<enum value::type> m_binding_type;
+    /** Builtin word the symbol resolves into, or null pointer. */
+    mutable native m_binding;
+    /** Inlined body of scripted word the symbol resolves into, if any. */
+    mutable std::shared_ptr<const std::vector<std::shared_ptr<node>>> m_body;
+    /** Whether specialization of the binding has been attempted. */
+    mutable bool m_quickened;
+    /** Specialization of the bound builtin word, or null pointer. */
+    mutable handler m_handler;
+    /** How many times an specialization has been discarded. */
+    mutable int m_deoptimizations;
   };
 
   class node::definition final : public node
@@ -292,4 +389,228 @@ namespace laskin
       return U"-> " + id;
     }
   };
+
+  /**
+   * Declaration of local variables, `-> ( a b )`, which takes values from the
+   * stack and stores them into slots of the activation frame of the current
+   * scope. The topmost value of the stack goes into the last variable.
+   */
+  class node::binding final : public node
+  {
+  public:
+    using container_type = std::vector<std::size_t>;
+
+    /** Scope that the variables belong to. */
+    const std::shared_ptr<const class scope> scope;
+    /** Slots of the variables, in the order they were declared. */
+    const container_type slots;
+
+    explicit binding(
+      const std::shared_ptr<const class scope>& scope_,
+      const container_type& slots_,
+      const std::optional<struct position>& position_ = std::nullopt
+    )
+      : node(position_)
+      , scope(scope_)
+      , slots(slots_) {}
+
+    inline enum type type() const override
+    {
+      return type::binding;
+    }
+
+    void exec(
+      class context& context,
+      std::ostream* out
+    ) const override;
+
+    value eval(
+      class context& context,
+      std::ostream* out
+    ) const override;
+
+    bool equals(const std::shared_ptr<node>& that) const override;
+
+    std::u32string to_source() const override;
+  };
+
+  /**
+   * Reference to an local variable. Just like words of the dictionary, quotes
+   * stored into local variables are called while other values are pushed
+   * onto the stack.
+   */
+  class node::local final : public node
+  {
+  public:
+    const std::u32string id;
+    /** Scope that the variable belongs to. */
+    const std::shared_ptr<const class scope> scope;
+    /** Slot of the variable in activation frames of the scope. */
+    const std::size_t slot;
+
+    explicit local(
+      const std::u32string& id_,
+      const std::shared_ptr<const class scope>& scope_,
+      std::size_t slot_,
+      const std::optional<struct position>& position_ = std::nullopt
+    )
+      : node(position_)
+      , id(id_)
+      , scope(scope_)
+      , slot(slot_) {}
+
+    inline enum type type() const override
+    {
+      return type::local;
+    }
+
+    void exec(
+      class context& context,
+      std::ostream* out
+    ) const override;
+
+    value eval(
+      class context& context,
+      std::ostream* out
+    ) const override;
+
+    bool equals(const std::shared_ptr<node>& that) const override;
+
+    inline std::u32string to_source() const override
+    {
+      return id;
+    }
+  };
+
+  /**
+   * Quote literal that refers to local variables of an enclosing quote. When
+   * evaluated, the quote captures copies of the variables it refers to, so
+   * that they remain accessible after the enclosing quote has returned. The
+   * variables are copied instead of capturing the activation frame itself,
+   * as the quote could be stored into that very frame, forming an reference
+   * cycle that would never be freed.
+   */
+  class node::closure final : public node
+  {
+  public:
+    /** Local variables referred to by the quote, by scope and slot. */
+    using capture_container = std::vector<
+      std::pair<const class scope*, std::size_t>
+    >;
+
+    const class value value;
+    /** Local variables of enclosing quotes that are captured. */
+    const capture_container captures;
+
+    explicit closure(
+      const class value& value_,
+      const std::optional<struct position>& position_ = std::nullopt
+    );
+
+    inline enum type type() const override
+    {
+      return type::closure;
+    }
+
+    void exec(
+      class context& context,
+      std::ostream* out
+    ) const override;
+
+    class value eval(
+      class context& context,
+      std::ostream* out
+    ) const override;
+
+    bool equals(const std::shared_ptr<node>& that) const override;
+
+    inline std::u32string to_source() const override
+    {
+      return value.to_source();
+    }
+  };
+
+  /**
+   * Base class for AST nodes produced by the optimizer. These only appear in
+   * the compiled form of quotes, where they replace sequence of the original
+   * nodes. The original nodes are kept around and executed instead whenever
+   * the assumptions made by the optimizer no longer hold, such as when an
+   * builtin word has been redefined.
+   */
+  class node::compiled : public node
+  {
+  public:
+    using container_type = std::vector<std::shared_ptr<node>>;
+
+    /**
+     * Assumption about symbol resolution made by the optimizer. The symbol
+     * must resolve into given builtin word when value of given type is on top
+     * of the stack, or regardless of the stack contents when no type is
+     * given. If the word is null pointer, the symbol must not be defined in
+     * the dictionary at all.
+     */
+    struct guard
+    {
+      std::u32string id;
+      std::optional<enum value::type> type;
+      symbol::native word;
+    };
+    using guard_container = std::vector<guard>;
+
+    /** The original nodes replaced by this one. */
+    const container_type nodes;
+    /** Assumptions that must hold for the optimized code to be used. */
+    const guard_container guards;
+
+    explicit compiled(
+      const container_type& nodes_,
+      const guard_container& guards_,
+      const std::optional<struct position>& position_ = std::nullopt
+    )
+      : node(position_)
+      , nodes(nodes_)
+      , guards(guards_)
+      , m_validated(false)
+      , m_generation(0) {}
+
+    inline enum type type() const override
+    {
+      return type::compiled;
+    }
+
+    void exec(
+      class context& context,
+      std::ostream* out
+    ) const override;
+
+    value eval(
+      class context& context,
+      std::ostream* out
+    ) const override;
+
+    bool equals(const std::shared_ptr<node>& that) const override;
+
+    std::u32string to_source() const override;
+
+  protected:
+    /**
+     * Executes the optimized code. Returns `false` without touching the stack
+     * if the optimized code is unable to handle current contents of the
+     * stack, in which case the original nodes are executed instead.
+     */
+    virtual bool run(class context& context, std::ostream* out) const = 0;
+
+  private:
+    /**
+     * Tests whether the guards hold in given context. Result of the test is
+     * cached until the dictionary of the context changes.
+     */
+    bool validate(const class context& context) const;
+
+  private:
+    /** Whether the guards have been found to hold. */
+    mutable bool m_validated;
+    /** Dictionary generation in which the guards were found to hold. */
+    mutable std::uint64_t m_generation;
+  };
 }
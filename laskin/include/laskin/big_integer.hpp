@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <string>
+
+#include <gmp.h>
+
+namespace laskin
+{
+  /**
+   * Arbitrary precision integer, into which results of integer arithmetic
+   * are promoted when they no longer fit into long integer. Unlike the
+   * arbitrary precision floating point numbers, addition, substraction,
+   * multiplication, modulo and exponentiation of these are always exact.
+   */
+  class big_integer
+  {
+  public:
+    /**
+     * Constructs big integer from long integer.
+     */
+    explicit big_integer(long value = 0);
+
+    /**
+     * Constructs copy of existing big integer.
+     */
+    big_integer(const big_integer& that);
+
+    /**
+     * Move constructor.
+     */
+    big_integer(big_integer&& that);
+
+    /**
+     * Destructor.
+     */
+    ~big_integer();
+
+    /**
+     * Copies value of another big integer into this one.
+     */
+    big_integer& operator=(const big_integer& that);
+
+    /**
+     * Moves value of another big integer into this one.
+     */
+    big_integer& operator=(big_integer&& that);
+
+    /**
+     * Parses decimal integer, optionally preceded with sign, from given
+     * string into the result. Returns boolean flag telling whether the
+     * string contained valid integer.
+     */
+    static bool parse(const std::string& input, big_integer& result);
+
+    /**
+     * Raises integer into given power. Returns `false` if the exponent is
+     * negative or if the result would be too large to be computed, in which
+     * case the operation should be performed with arbitrary precision
+     * floating point numbers instead.
+     */
+    static bool power(
+      const big_integer& base,
+      long exponent,
+      big_integer& result
+    );
+
+    /**
+     * Tests whether the integer fits into long integer.
+     */
+    bool fits_long() const;
+
+    /**
+     * Returns the integer as long integer. Must only be called when
+     * `fits_long()` returns `true`.
+     */
+    long to_long() const;
+
+    /**
+     * Tests whether the integer is zero.
+     */
+    bool is_zero() const;
+
+    /**
+     * Returns decimal representation of the integer.
+     */
+    std::string to_string() const;
+
+    /**
+     * Compares two integers against each other.
+     */
+    int compare(const big_integer& that) const;
+
+    big_integer operator+(const big_integer& that) const;
+    big_integer operator-(const big_integer& that) const;
+    big_integer operator*(const big_integer& that) const;
+
+    /**
+     * Performs modulo operation, with the sign of the result following the
+     * dividend just like with long integers. The divisor must not be zero.
+     */
+    big_integer operator%(const big_integer& that) const;
+
+  private:
+    mpz_t m_value;
+  };
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "laskin/quote.hpp"
+
+namespace laskin::builtins
+{
+  /**
+   * Name of an builtin word and the function that implements it.
+   */
+  using definition = std::pair<std::u32string_view, quote::native>;
+
+  /**
+   * FNV-1a hash of an word name, mixed with given seed. Used to construct the
+   * perfect hash table of builtin words.
+   */
+  constexpr std::uint32_t hash(std::u32string_view id, std::uint32_t seed)
+  {
+    std::uint32_t result = 2166136261u ^ seed;
+
+    for (std::u32string_view::size_type i = 0; i < id.length(); ++i)
+    {
+      result = (result ^ static_cast<std::uint32_t>(id[i])) * 16777619u;
+    }
+
+    return result ^ (result >> 15);
+  }
+
+  /**
+   * Returns all builtin words provided by the interpreter.
+   */
+  const std::vector<definition>& all();
+
+  /**
+   * Searches for an builtin word with given name from the perfect hash table
+   * of builtin words. Returns null pointer if there is no such builtin word.
+   */
+  quote::native find(std::u32string_view id);
+
+  /**
+   * Returns stack effect of an builtin word with given name, in the same
+   * notation as used in the documentation of the word, such as
+   * `( number number -- number )`. Single letters are used as type variables
+   * for words that shuffle the stack, type names separated with `|` denote
+   * values that can be of any of the listed types and `any...` denotes an
+   * variable number of values. Empty value is returned if there is no such
+   * builtin word.
+   */
+  std::optional<std::u32string_view> signature(std::u32string_view id);
+}
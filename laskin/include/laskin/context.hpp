@@ -25,20 +25,52 @@
  */
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <deque>
+#include <string_view>
 #include <unordered_map>
 
+#include "laskin/numeric.hpp"
 #include "laskin/quote.hpp"
+#include "laskin/random.hpp"
 
 namespace laskin
 {
+  class parse_cache;
+  class profiler;
+
+  /**
+   * Activation frame that holds values of the local variables declared in an
+   * scope, for single call of an quote.
+   */
+  class frame
+  {
+  public:
+    /** Scope that the local variables belong to. */
+    const std::shared_ptr<const class scope> scope;
+    /** Frame of the lexically enclosing quote, if any. */
+    const std::shared_ptr<frame> parent;
+    /** Values of the local variables, indexed by their slot. */
+    std::vector<value> slots;
+
+    explicit frame(
+      const std::shared_ptr<const class scope>& scope_,
+      const std::shared_ptr<frame>& parent_
+    )
+      : scope(scope_)
+      , parent(parent_)
+      , slots(scope_->names.size()) {}
+  };
+
   class context
   {
   public:
     using container_type = std::deque<value>;
     using dictionary_type = std::unordered_map<std::u32string, value>;
+    using method_table = std::unordered_map<std::u32string, value>;
     using dictionary_definition = std::initializer_list<
-      std::pair<std::u32string, quote::callback>
+      std::pair<std::u32string_view, quote::native>
     >;
     using dictionary_default_callback = std::function<
       std::optional<value>(const std::u32string&)
@@ -46,12 +78,35 @@ namespace laskin
 
     /** Container for stack data. */
     container_type data;
-    /** Container for dictionary definitions. */
-    dictionary_type dictionary;
     /** Invoked when dictionary item is missing. */
     dictionary_default_callback default_callback;
     /** Whether include word should be allowed or not. */
     bool allow_include;
+    /**
+     * When set, quotes are executed without optimizations and sequences of
+     * executed words are recorded into the profiler.
+     */
+    std::shared_ptr<class profiler> profiler;
+    /**
+     * Activation frame of the quote being executed, if it has declared local
+     * variables.
+     */
+    std::shared_ptr<class frame> frame;
+    /**
+     * Cache used for programs parsed from strings at runtime. By default all
+     * contexts of the same thread share the same cache, but the context can
+     * be given an cache of it's own with different size, or caching can be
+     * disabled by setting this to null. The cache must not be shared with
+     * contexts used by other threads.
+     */
+    std::shared_ptr<class parse_cache> parse_cache;
+    /** Determines how numbers without measurement unit are computed. */
+    class numeric numeric;
+    /**
+     * Random number generator of the context. Copies of the context continue
+     * from the same state, unless they are jumped or seeded differently.
+     */
+    class random_generator random;
 
     explicit context(
       const dictionary_default_callback& default_callback_ = nullptr,
@@ -112,6 +167,66 @@ namespace laskin
       std::ostream* out = nullptr
     );
 
+    /**
+     * Returns the dictionary definitions. The dictionary can only be modified
+     * through `define()` and `undefine()`, so that typed words and the
+     * generation of the dictionary are kept in sync with it.
+     */
+    inline const dictionary_type& dictionary() const
+    {
+      return m_dictionary;
+    }
+
+    /**
+     * Inserts an word into the dictionary. If the name of the word is prefixed
+     * with name of an value type, such as `number:sqrt`, it will also be
+     * registered as method of that type.
+     */
+    void define(const std::u32string& id, const class value& value);
+
+    /**
+     * Removes an word from the dictionary. Returns `false` if the dictionary
+     * did not contain such word.
+     */
+    bool undefine(const std::u32string& id);
+
+    /**
+     * Tests whether given symbol has been defined in the dictionary, either as
+     * an word or as an typed word of any value type.
+     */
+    bool is_defined(const std::u32string& id) const;
+
+    /**
+     * Returns an number identifying the current state of the dictionary.
+     * Generation changes whenever an word is added into or removed from the
+     * dictionary, or when an quote is involved in redefinition of an word, so
+     * results of symbol resolution can be cached until it changes.
+     * Generations are drawn from an process-wide counter, so no two contexts
+     * share an generation unless one of them is an copy of the other.
+     */
+    inline std::uint64_t generation() const
+    {
+      return m_generation;
+    }
+
+    /**
+     * Returns the word that given symbol resolves into, regardless of what is
+     * on top of the stack. Null pointer is returned if the symbol has not
+     * been defined, or if the resolution depends on type of the topmost value
+     * of the stack.
+     */
+    const class value* resolve(const std::u32string& id) const;
+
+    /**
+     * Returns the word that given symbol resolves into when value of given
+     * type is on top of the stack, or null pointer if the symbol has not been
+     * defined.
+     */
+    const class value* resolve(
+      const std::u32string& id,
+      enum value::type type
+    ) const;
+
     /**
      * Performs an dictionary lookup on the context or throws `error` instance
      * if the given identifier/symbol cannot be found from the dictionary or
@@ -284,5 +399,16 @@ namespace laskin
     {
       return data.empty();
     }
+
+  private:
+    /** Container for dictionary definitions. */
+    dictionary_type m_dictionary;
+    /** Current generation of the dictionary. */
+    std::uint64_t m_generation;
+    /**
+     * Typed words of the dictionary, indexed by the value type and the name of
+     * the word without the type prefix.
+     */
+    std::array<method_table, value::type_count> m_methods;
   };
 }
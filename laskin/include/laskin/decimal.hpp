@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "laskin/value.hpp"
+
+/**
+ * Parsing of decimal number literals without going through arbitrary
+ * precision numbers.
+ */
+namespace laskin::decimal
+{
+  /**
+   * Result of parsing an decimal number.
+   */
+  enum class errc
+  {
+    /** The number was parsed successfully. */
+    ok,
+    /** The input does not contain decimal number. */
+    invalid,
+    /** The number has measurement unit that is not recognized. */
+    unknown_unit,
+    /**
+     * The number cannot be represented exactly without arbitrary precision
+     * parsing, either because it's an integer that does not fit into long,
+     * because it's out of range of double or because the precision of
+     * arbitrary precision numbers has been changed.
+     */
+    out_of_range,
+  };
+
+  /**
+   * Validates and converts decimal number with optional fraction, exponent
+   * and measurement unit in single pass over the input. Whole numbers
+   * without measurement unit become integer values. Nothing is thrown; the
+   * result is assigned only when `errc::ok` is returned.
+   */
+  errc parse(const std::u32string& input, value& result);
+}
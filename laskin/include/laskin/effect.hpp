@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "laskin/quote.hpp"
+
+namespace laskin
+{
+  /**
+   * Stack effect of an word or quote: types of the values it takes from the
+   * stack and types of the values it leaves there in their place, both listed
+   * from the bottom of the stack to the top. Type of an value is left empty
+   * when it can be of any type.
+   *
+   * Stack effects are inferred by interpreting the AST nodes of an quote with
+   * types instead of values, using the signatures of the builtin words. Calls
+   * to scripted words and literal quotes given to words such as `if` and
+   * `quote:call` are followed, but as soon as the outcome depends on
+   * something that is only known at runtime, such as an quote taken from the
+   * stack, the effect is considered to be unknown.
+   */
+  class effect
+  {
+  public:
+    using type_container = std::vector<std::optional<enum value::type>>;
+
+    /** Types of the values taken from the stack. */
+    type_container inputs;
+    /** Types of the values left on the stack. */
+    type_container outputs;
+
+    explicit effect(
+      const type_container& inputs_ = type_container(),
+      const type_container& outputs_ = type_container()
+    )
+      : inputs(inputs_)
+      , outputs(outputs_) {}
+
+    LASKIN_DEFAULT_COPY_AND_ASSIGN(effect);
+
+    /**
+     * Infers stack effect of given quote when it's called in given context,
+     * without calling it. Empty value is returned if the effect cannot be
+     * determined statically. If the quote is certain to fail with an error,
+     * such as when an string is given to an word that expects an number,
+     * `error` instance will be thrown.
+     */
+    static std::optional<effect> infer(
+      const quote& quote,
+      const class context& context
+    );
+
+    /**
+     * Checks given program for errors that are certain to happen when it's
+     * executed in given context, starting with an empty stack, without
+     * executing it. In addition to the errors detected by `infer()`, stack
+     * underflows and unrecognized symbols are detected as well as errors
+     * inside quotes that are defined but not called by the program. First
+     * error found is thrown as `error` instance.
+     */
+    static void check(const quote& program, const class context& context);
+
+    /**
+     * Converts the stack effect into the same notation as used in the
+     * documentation of the builtin words, such as `( number -- boolean )`.
+     */
+    std::u32string to_source() const;
+  };
+}
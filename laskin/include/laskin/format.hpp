@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <cstddef>
+
+#include "laskin/value.hpp"
+
+/**
+ * Formatting of numbers without going through arbitrary precision numbers.
+ */
+namespace laskin::format
+{
+  /**
+   * Size of an buffer that is large enough to hold any number formatted by
+   * the functions below.
+   */
+  constexpr std::size_t buffer_size = 32;
+
+  /**
+   * Writes decimal representation of given integer into the buffer. Returns
+   * pointer to the end of the written characters.
+   */
+  char* integer(char* buffer, long value);
+
+  /**
+   * Writes the shortest decimal representation of given double that parses
+   * back into the same double into the buffer. Numbers from 1e-6 up to 1e21
+   * in magnitude are written in fixed notation, and others with an exponent.
+   * Returns pointer to the end of the written characters, or null pointer if
+   * the double is not finite.
+   */
+  char* real(char* buffer, double value);
+
+  /**
+   * Writes given number into the buffer, if it's an machine integer, an real
+   * value or an arbitrary precision number without measurement unit that is
+   * exactly representable as double. Returns pointer to the end of the
+   * written characters, or null pointer if the number has to be formatted
+   * with arbitrary precision instead.
+   */
+  char* number(char* buffer, const value& value);
+}
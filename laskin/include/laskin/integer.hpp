@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+namespace laskin::integer
+{
+  /**
+   * Adds two integers. Returns `false` if the result does not fit into long
+   * integer, in which case the operation should be performed with arbitrary
+   * precision numbers instead.
+   */
+  inline bool add(long a, long b, long& result)
+  {
+    return !__builtin_add_overflow(a, b, &result);
+  }
+
+  /**
+   * Substracts two integers. Returns `false` if the result does not fit into
+   * long integer.
+   */
+  inline bool substract(long a, long b, long& result)
+  {
+    return !__builtin_sub_overflow(a, b, &result);
+  }
+
+  /**
+   * Multiplies two integers. Returns `false` if the result does not fit into
+   * long integer.
+   */
+  inline bool multiply(long a, long b, long& result)
+  {
+    return !__builtin_mul_overflow(a, b, &result);
+  }
+
+  /**
+   * Performs modulo operation on two integers, with the sign of the result
+   * following the dividend. Returns `false` if the divisor is zero.
+   */
+  inline bool modulo(long a, long b, long& result)
+  {
+    if (!b)
+    {
+      return false;
+    }
+    // Avoid overflow of the smallest possible integer divided by -1.
+    result = b == -1 ? 0 : a % b;
+
+    return true;
+  }
+
+  /**
+   * Raises integer into given power. Returns `false` if the exponent is
+   * negative or if the result does not fit into long integer.
+   */
+  bool power(long base, long exponent, long& result);
+}
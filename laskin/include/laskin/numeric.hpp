@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "laskin/value.hpp"
+
+namespace laskin
+{
+  /**
+   * Numeric policy of an context, which determines how numbers without
+   * measurement unit are represented and computed.
+   */
+  class numeric
+  {
+  public:
+    enum class mode
+    {
+      /** Numbers are arbitrary precision floating point numbers. */
+      mpfr,
+      /**
+       * Numbers without measurement unit are stored as IEEE doubles and math
+       * words are computed with the C library instead of MPFR.
+       */
+      fast,
+    };
+
+    explicit numeric(enum mode mode = mode::mpfr);
+
+    /**
+     * Returns the numeric mode.
+     */
+    inline enum mode mode() const
+    {
+      return m_mode;
+    }
+
+    /**
+     * Tests whether numbers without measurement unit are computed as IEEE
+     * doubles.
+     */
+    inline bool is_fast() const
+    {
+      return m_mode == mode::fast;
+    }
+
+    /**
+     * Sets the numeric mode.
+     */
+    inline void set_mode(enum mode mode)
+    {
+      m_mode = mode;
+    }
+
+    /**
+     * Returns the precision, in bits, used for new arbitrary precision
+     * numbers.
+     */
+    static long precision();
+
+    /**
+     * Sets the precision, in bits, used for new arbitrary precision numbers.
+     * MPFR keeps the precision per thread, so it's shared by all contexts
+     * of the current thread. Range error is thrown if the precision is not
+     * supported by MPFR.
+     */
+    static void set_precision(long bits);
+
+    /**
+     * Tests whether arbitrary precision numbers of the current thread have
+     * always had the precision of an double, in which case arithmetic on
+     * doubles rounds exactly like arithmetic on them would, as long as the
+     * results stay within the normal range of doubles.
+     */
+    static bool is_double_precision();
+
+    /**
+     * Converts number without measurement unit into an real value, if the
+     * mode is fast. Other values are returned as they are.
+     */
+    inline value coerce(value value) const
+    {
+      if (m_mode != mode::fast || !value.is(value::type::number))
+      {
+        return value;
+      }
+
+      return to_real(value);
+    }
+
+  private:
+    static value to_real(const value& value);
+
+  private:
+    enum mode m_mode;
+  };
+}
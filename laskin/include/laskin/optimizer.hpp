@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "laskin/effect.hpp"
+#include "laskin/quote.hpp"
+
+namespace laskin::optimizer
+{
+  /**
+   * Sequence of nodes that has been folded into pushing constant values onto
+   * the stack. Sequences that have no effect at all, such as `dup drop`, are
+   * folded into an node that pushes nothing, but still requires the stack to
+   * contain as many values as the original sequence would have needed.
+   */
+  class folded final : public node::compiled
+  {
+  public:
+    /** Values pushed onto the stack. */
+    const std::vector<value> values;
+    /** Minimum number of values the stack must contain beforehand. */
+    const std::size_t depth;
+
+    explicit folded(
+      const std::vector<value>& values_,
+      std::size_t depth_,
+      const container_type& nodes_,
+      const guard_container& guards_
+    )
+      : node::compiled(nodes_, guards_)
+      , values(values_)
+      , depth(depth_) {}
+
+  protected:
+    bool run(class context& context, std::ostream* out) const override;
+  };
+
+  /**
+   * Lowered form of `if` and `if-else` with literal quotes, which executes
+   * either one of the quotes directly, based on the boolean value on top of
+   * the stack.
+   */
+  class branch final : public node::compiled
+  {
+  public:
+    /** Quote executed when the condition is true. */
+    const quote then_quote;
+    /** Quote executed when the condition is false, if any. */
+    const std::optional<quote> else_quote;
+
+    explicit branch(
+      const quote& then_quote_,
+      const std::optional<quote>& else_quote_,
+      const container_type& nodes_,
+      const guard_container& guards_,
+      const std::optional<struct position>& position_
+    )
+      : node::compiled(nodes_, guards_, position_)
+      , then_quote(then_quote_)
+      , else_quote(else_quote_) {}
+
+  protected:
+    bool run(class context& context, std::ostream* out) const override;
+  };
+
+  /**
+   * Lowered form of `while` with literal quotes, which executes the quotes
+   * directly without placing them onto the stack first.
+   */
+  class loop final : public node::compiled
+  {
+  public:
+    /** Quote that pushes the loop condition onto the stack. */
+    const quote condition;
+    /** Quote executed as long as the condition is true. */
+    const quote body;
+
+    explicit loop(
+      const quote& condition_,
+      const quote& body_,
+      const container_type& nodes_,
+      const guard_container& guards_,
+      const std::optional<struct position>& position_
+    )
+      : node::compiled(nodes_, guards_, position_)
+      , condition(condition_)
+      , body(body_) {}
+
+  protected:
+    bool run(class context& context, std::ostream* out) const override;
+  };
+
+  /**
+   * Lowered form of `number:times` with literal quote and constant count,
+   * which executes the quote directly without placing it and the count onto
+   * the stack first.
+   */
+  class repeat final : public node::compiled
+  {
+  public:
+    /** Quote executed repeatedly. */
+    const quote body;
+    /** How many times the quote is executed. */
+    const number count;
+
+    explicit repeat(
+      const quote& body_,
+      const number& count_,
+      const container_type& nodes_,
+      const guard_container& guards_,
+      const std::optional<struct position>& position_
+    )
+      : node::compiled(nodes_, guards_, position_)
+      , body(body_)
+      , count(count_) {}
+
+  protected:
+    bool run(class context& context, std::ostream* out) const override;
+  };
+
+  /**
+   * Sequence of words fused into single node with native implementation,
+   * also known as superinstruction.
+   */
+  class fused final : public node::compiled
+  {
+  public:
+    /**
+     * Native implementation of the fused words. Returns `false` without
+     * touching the stack if the stack contents are not what it expects.
+     */
+    using handler = bool(*)(class context&, std::ostream*);
+
+    /** Native implementation of the fused words. */
+    const handler function;
+
+    explicit fused(
+      handler function_,
+      const container_type& nodes_,
+      const guard_container& guards_
+    )
+      : node::compiled(nodes_, guards_)
+      , function(function_) {}
+
+  protected:
+    inline bool run(class context& context, std::ostream* out) const override
+    {
+      return function(context, out);
+    }
+  };
+
+  /**
+   * Chain of `vector:map` and `vector:filter` calls, where every call after
+   * the first one is given an literal quote, such as
+   * `vector:map ( p ) swap vector:filter ( + ) swap vector:reduce`. The chain
+   * is fused into single pass over the vector, so that no intermediate
+   * vectors are constructed. The chain may end with `vector:reduce`, in which
+   * case no vector is constructed at all, or with `vector:sum`, which is
+   * given the values that the last stage produces.
+   *
+   * As the stages are interleaved, only quotes consisting of constants and
+   * pure builtin words take part in the fusion, so that the order of side
+   * effects stays the same.
+   */
+  class pipeline final : public node::compiled
+  {
+  public:
+    enum class operation
+    {
+      map,
+      filter,
+      reduce,
+      sum,
+    };
+
+    struct stage
+    {
+      enum operation operation;
+      /** Quote given to the operation, if it takes one. */
+      std::optional<class quote> quote;
+    };
+
+    /** Operation performed with the quote taken from the stack. */
+    const enum operation first;
+    /** Operations following the first one. */
+    const std::vector<stage> stages;
+
+    explicit pipeline(
+      enum operation first_,
+      const std::vector<stage>& stages_,
+      const container_type& nodes_,
+      const guard_container& guards_,
+      const std::optional<struct position>& position_
+    )
+      : node::compiled(nodes_, guards_, position_)
+      , first(first_)
+      , stages(stages_) {}
+
+  protected:
+    bool run(class context& context, std::ostream* out) const override;
+  };
+
+  /**
+   * Sequence of stack manipulation words and operators, whose stack effect
+   * has been inferred when the quote was compiled. The stack is checked only
+   * once before the sequence is executed, after which the words operate on
+   * the stack directly, without checking for underflow on every pop.
+   */
+  class unchecked final : public node::compiled
+  {
+  public:
+    /**
+     * Native implementation of an word, which assumes that the stack
+     * contains enough values for it.
+     */
+    using operation = void(*)(class context&);
+
+    /** Types of the values the sequence takes from the stack. */
+    const effect::type_container inputs;
+    /** Implementations of the words, in the order they are executed. */
+    const std::vector<operation> operations;
+
+    explicit unchecked(
+      const effect::type_container& inputs_,
+      const std::vector<operation>& operations_,
+      const container_type& nodes_,
+      const guard_container& guards_
+    )
+      : node::compiled(nodes_, guards_)
+      , inputs(inputs_)
+      , operations(operations_) {}
+
+  protected:
+    bool run(class context& context, std::ostream* out) const override;
+  };
+
+  /**
+   * Constructs optimized version of given AST nodes, which is used as the
+   * compiled form of scripted quotes. Nested quote literals are not touched,
+   * as they will be optimized once they are called.
+   */
+  quote::node_container optimize(const quote::node_container& nodes);
+}
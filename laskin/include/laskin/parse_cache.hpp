@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+#include "laskin/quote.hpp"
+
+namespace laskin
+{
+  /**
+   * Bounded cache of programs parsed from strings at runtime, so that
+   * evaluating the same source code repeatedly does not have to go through
+   * the parser every time. When the cache is full, the least recently used
+   * program is discarded from it.
+   *
+   * The cache is not thread safe and must only be used by single thread.
+   * Quotes returned from the cache are shared with every other user of it,
+   * and they compile themselves and cache the bindings of their symbols when
+   * they are executed for the first time, without any synchronization.
+   */
+  class parse_cache
+  {
+  public:
+    /**
+     * Constructs new cache that holds up to given number of programs.
+     */
+    explicit parse_cache(std::size_t capacity = 256);
+
+    LASKIN_DISALLOW_COPY_AND_ASSIGN(parse_cache);
+
+    /**
+     * Returns the cache shared by all contexts of the current thread by
+     * default. Each thread has an cache of it's own.
+     */
+    static const std::shared_ptr<parse_cache>& shared();
+
+    /**
+     * Returns the program parsed from given source code, either from the
+     * cache or by parsing it. Syntax errors are not cached.
+     */
+    quote parse(const std::u32string& source);
+
+    /**
+     * Returns the maximum number of programs held in the cache.
+     */
+    std::size_t capacity() const;
+
+    /**
+     * Changes the maximum number of programs held in the cache, discarding
+     * least recently used ones if necessary. Capacity of zero disables the
+     * cache.
+     */
+    void resize(std::size_t capacity);
+
+    /**
+     * Discards all programs from the cache and resets the counters.
+     */
+    void clear();
+
+    /**
+     * Returns number of lookups that were found from the cache.
+     */
+    std::size_t hits() const;
+
+    /**
+     * Returns number of lookups that had to be parsed.
+     */
+    std::size_t misses() const;
+
+  private:
+    void trim();
+
+  private:
+    using entry_list = std::list<std::pair<std::u32string, quote>>;
+
+    std::size_t m_capacity;
+    std::size_t m_hits;
+    std::size_t m_misses;
+    /** Cached programs, ordered from most recently used to the least. */
+    entry_list m_entries;
+    /** Cached programs indexed by their source code. */
+    std::unordered_map<std::u32string_view, entry_list::iterator> m_index;
+  };
+}
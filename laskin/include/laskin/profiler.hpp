@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <unordered_map>
+
+#include "laskin/quote.hpp"
+
+namespace laskin
+{
+  /**
+   * Collects statistics about sequences of words executed by an program. The
+   * results are used for finding out which sequences of words are worth
+   * fusing together by the optimizer.
+   */
+  class profiler
+  {
+  public:
+    using counter_type = std::unordered_map<std::u32string, std::size_t>;
+    using result_type = std::vector<std::pair<std::u32string, std::size_t>>;
+
+    /**
+     * Constructs new profiler which records sequences of up to given number
+     * of words.
+     */
+    explicit profiler(std::size_t max_length = 3);
+
+    LASKIN_DISALLOW_COPY_AND_ASSIGN(profiler);
+
+    /**
+     * Records execution of node at given offset, along with the sequences of
+     * words beginning from it.
+     */
+    void record(
+      const quote::node_container& nodes,
+      quote::node_container::size_type offset
+    );
+
+    /**
+     * Returns given number of the most frequently executed sequences of
+     * words, sorted by their execution count in descending order.
+     */
+    result_type most_frequent(std::size_t count) const;
+
+  private:
+    const std::size_t m_max_length;
+    counter_type m_counters;
+  };
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <optional>
+
+#include "laskin/units.hpp"
+#include "laskin/value.hpp"
+
+namespace laskin
+{
+  /**
+   * Dense representation of an vector of numbers that all share the same
+   * measurement unit, or lack one. Magnitudes are stored as doubles, so that
+   * arithmetic on them can be performed without checking and converting the
+   * unit of each element separately.
+   */
+  class quantities
+  {
+  public:
+    using container_type = std::vector<double>;
+    using size_type = container_type::size_type;
+
+    /** Measurement unit shared by all of the numbers. */
+    units::id unit = units::none;
+    /**
+     * Whether the numbers were real values, in which case the results are
+     * real values as well.
+     */
+    bool real = false;
+    /** Magnitudes of the numbers. */
+    container_type magnitudes;
+
+    /**
+     * Extracts magnitudes of given vector, if all of it's elements are
+     * numbers with the same measurement unit and arithmetic on doubles gives
+     * identical results to the arithmetic on the numbers themselves. Unless
+     * `integers` is true, vectors consisting only of integers are not
+     * extracted, as arithmetic on them is exact already.
+     */
+    static std::optional<quantities> extract(
+      const vector& elements,
+      bool integers = false
+    );
+
+    /**
+     * Extracts unit and magnitude of single number, under the same
+     * conditions as `extract()` does.
+     */
+    static bool extract(
+      const value& value,
+      units::id& unit,
+      double& magnitude,
+      bool& real
+    );
+
+    /**
+     * Tests whether given magnitude is an result that the arbitrary precision
+     * arithmetic would have produced as well.
+     */
+    static bool is_exact(double magnitude);
+
+    /**
+     * Converts given magnitude into number value with the shared measurement
+     * unit.
+     */
+    value box(double magnitude) const;
+
+    /**
+     * Converts all of the magnitudes into number values with the shared
+     * measurement unit.
+     */
+    vector box() const;
+
+    /**
+     * Sums all of the magnitudes together, using pairwise summation with
+     * compensated sums of the smallest blocks. Large sums are computed in
+     * multiple threads, but the result does not depend on the number of them.
+     * The result has to be checked with `is_exact()` before it's used.
+     */
+    double sum() const;
+  };
+}
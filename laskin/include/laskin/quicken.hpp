@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "laskin/quote.hpp"
+#include "laskin/value.hpp"
+
+namespace laskin::quicken
+{
+  /**
+   * Specialized implementation of an builtin word for certain operand types.
+   * Performs the operation and returns `true` if the values on top of the
+   * stack are of the types it has been specialized for, otherwise returns
+   * `false` without touching the stack, in which case the generic
+   * implementation of the word should be used instead.
+   */
+  using handler = node::symbol::handler;
+
+  /**
+   * Operation of an specialized builtin word performed directly on two
+   * values, without going through the stack.
+   */
+  using operation = value(*)(const value&, const value&);
+
+  /**
+   * Searches for specialized implementation of given builtin word for the
+   * types of the two topmost values on the stack of given context. Returns
+   * null pointer if the word has no such specialization.
+   */
+  handler find(quote::native word, const class context& context);
+
+  /**
+   * Quote that consists of an single builtin word, optionally preceded by an
+   * literal operand, such as `( + )`, `( 2 * )` or `( 0 > )`. Higher-order
+   * builtins such as `vector:map` use kernels to run such quotes for every
+   * element without going through the interpreter, and for operations that
+   * have been specialized for the operand types, without touching the stack
+   * at all.
+   */
+  class kernel
+  {
+  public:
+    /**
+     * Tests whether given quote can be run as an kernel in given context, in
+     * which case the kernel is returned. The value expected to be on top of
+     * the stack when the quote is called is used to resolve typed words.
+     */
+    static std::optional<kernel> match(
+      const class quote& quote,
+      const class context& context,
+      const class value& top
+    );
+
+    /**
+     * Runs the kernel with given argument on the stack and returns the value
+     * left on top of the stack.
+     */
+    class value operator()(
+      class context& context,
+      std::ostream* out,
+      const class value& argument
+    ) const;
+
+    /**
+     * Runs the kernel with given two arguments on the stack and returns the
+     * value left on top of the stack.
+     */
+    class value operator()(
+      class context& context,
+      std::ostream* out,
+      const class value& a,
+      const class value& b
+    ) const;
+
+    /**
+     * Returns the literal operand of the kernel, if it has one.
+     */
+    inline const std::optional<class value>& operand() const
+    {
+      return m_operand;
+    }
+
+    /**
+     * Tests whether the word called by the kernel is an binary operator, i.e.
+     * one that replaces two values on top of the stack with an single value.
+     */
+    bool is_binary() const;
+
+  private:
+    explicit kernel(
+      const class quote& quote,
+      quote::native word,
+      const std::optional<class value>& operand,
+      const std::optional<enum value::type>& binding_type
+    )
+      : m_quote(quote)
+      , m_word(word)
+      , m_operand(operand)
+      , m_binding_type(binding_type) {}
+
+    operation find(const class value& a, const class value& b) const;
+
+    static class value apply(
+      const class context& context,
+      operation function,
+      const class value& a,
+      const class value& b
+    );
+
+    class value call(
+      class context& context,
+      std::ostream* out,
+      std::initializer_list<const class value*> arguments
+    ) const;
+
+    class value fallback(
+      class context& context,
+      std::ostream* out,
+      std::initializer_list<const class value*> arguments
+    ) const;
+
+  private:
+    /** The quote itself, for when the typed word does not apply. */
+    quote m_quote;
+    /** Builtin word called by the quote. */
+    quote::native m_word;
+    /** Literal pushed onto the stack before the word is called, if any. */
+    std::optional<class value> m_operand;
+    /** Type of topmost value the word was resolved with, if typed word. */
+    std::optional<enum value::type> m_binding_type;
+  };
+}
@@ -27,12 +27,17 @@
 
 #include <functional>
 #include <iostream>
+#include <optional>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 
 #include "laskin/ast.hpp"
 
 namespace laskin
 {
+  class frame;
+
   /**
    * Quote is collection of code or an C++ function callback that can be
    * executed with execution context. Basically an function.
@@ -44,27 +49,95 @@ namespace laskin
       context&,
       std::ostream*
     )>;
+    using native = void(*)(
+      context&,
+      std::ostream*
+    );
     using node_container = std::vector<std::shared_ptr<node>>;
 
+    /**
+     * Source code of an quote literal that has not been parsed yet. When
+     * parsing is deferred, the parser only skims over the quote literal and
+     * the AST nodes are constructed when they are needed for the first time,
+     * so that programs do not pay for parsing code they never use.
+     */
+    class deferred
+    {
+    public:
+      /** Source code that contains the quote literal. */
+      const std::shared_ptr<const std::u32string> source;
+      /** Offset of the first character after the opening parenthesis. */
+      const std::u32string::size_type begin;
+      /** Offset of the first character after the closing parenthesis. */
+      const std::u32string::size_type end;
+      /** Position of the first character after the opening parenthesis. */
+      const struct position position;
+
+      explicit deferred(
+        const std::shared_ptr<const std::u32string>& source_,
+        std::u32string::size_type begin_,
+        std::u32string::size_type end_,
+        const struct position& position_
+      )
+        : source(source_)
+        , begin(begin_)
+        , end(end_)
+        , position(position_) {}
+
+      LASKIN_DISALLOW_COPY_AND_ASSIGN(deferred);
+
+      /**
+       * Parses the quote literal, unless it has already been parsed, and
+       * returns it's AST nodes.
+       */
+      const node_container& nodes();
+
+      /**
+       * Tests whether the quote literal declares local variables.
+       */
+      bool is_scoped();
+
+      /**
+       * Returns the source code between the parentheses.
+       */
+      inline std::u32string_view text() const
+      {
+        return std::u32string_view(*source).substr(begin, end - begin - 1);
+      }
+
+    private:
+      std::optional<node_container> m_nodes;
+      std::optional<bool> m_scoped;
+    };
+
+    /**
+     * Parses given source code into an quote. If the `lazy` flag is set,
+     * parsing of quote literals contained in the source code is deferred
+     * until they are needed, which also defers reporting of most syntax
+     * errors inside them.
+     */
     static quote parse(
       const std::u32string& source,
       const std::optional<std::filesystem::path>& path = std::nullopt,
       int line = 1,
-      int column = 1
+      int column = 1,
+      bool lazy = false
     );
 
     static quote parse(
       const std::string& source,
       const std::optional<std::filesystem::path>& path = std::nullopt,
       int line = 1,
-      int column = 1
+      int column = 1,
+      bool lazy = false
     );
 
     static quote parse(
       std::istream& input,
       const std::optional<std::filesystem::path>& path = std::nullopt,
       int line = 1,
-      int column = 1
+      int column = 1,
+      bool lazy = false
     );
 
     /**
@@ -77,11 +150,38 @@ namespace laskin
      */
     quote(const callback& cb);
 
+    /**
+     * Constructs native quote from given function pointer. Unlike quotes
+     * constructed from `std::function` callbacks, these are invoked directly
+     * without any type erasure.
+     */
+    quote(native fn);
+
+    /**
+     * Constructs native quote from an lambda that does not capture anything,
+     * by converting it into plain function pointer.
+     */
+    template<
+      class T,
+      class = std::enable_if_t<
+        std::is_convertible_v<T, native> &&
+        !std::is_same_v<std::decay_t<T>, native>
+      >
+    >
+    quote(const T& fn)
+      : quote(static_cast<native>(fn)) {}
+
     /**
      * Constructs scripted quote from given AST nodes.
      */
     quote(const node_container& nodes);
 
+    /**
+     * Constructs scripted quote from source code whose parsing has been
+     * deferred.
+     */
+    quote(const std::shared_ptr<deferred>& source);
+
     LASKIN_DEFAULT_COPY_AND_ASSIGN(quote);
 
     /**
@@ -92,6 +192,17 @@ namespace laskin
       return !std::holds_alternative<node_container>(m_container);
     }
 
+    /**
+     * Returns the function pointer of an native quote constructed from one,
+     * or null pointer for other kinds of quotes.
+     */
+    inline native target() const
+    {
+      const auto fn = std::get_if<native>(&m_container);
+
+      return fn ? *fn : nullptr;
+    }
+
     /**
      * Provides access to the AST nodes contained inside the quote, unless it's
      * a native quote instead of scripted one in which case an empty vector is
@@ -99,9 +210,34 @@ namespace laskin
      */
     inline node_container nodes() const
     {
-      return is_native()
-        ? node_container()
-        : std::get<node_container>(m_container);
+      return is_native() ? node_container() : body();
+    }
+
+    /**
+     * Returns the optimized form of the AST nodes, which is what actually gets
+     * executed when the quote is called. It's constructed when requested for
+     * the first time and shared between copies of the quote. For native
+     * quotes an empty vector is returned.
+     *
+     * The compiled form is constructed without synchronization, so copies of
+     * an scripted quote must not be called by multiple threads at once.
+     */
+    std::shared_ptr<const node_container> compiled() const;
+
+    /**
+     * Returns copy of the quote that has access to local variables stored in
+     * given activation frame, which belongs to the lexically enclosing quote.
+     */
+    quote bind(const std::shared_ptr<class frame>& frame) const;
+
+    /**
+     * Tests whether calling the quote requires an activation frame, either
+     * because the quote declares local variables or because it refers to
+     * local variables of an enclosing quote.
+     */
+    inline bool is_scoped() const
+    {
+      return m_scoped || m_frame || (m_deferred && m_deferred->is_scoped());
     }
 
     /**
@@ -128,6 +264,25 @@ namespace laskin
     std::u32string to_source() const;
 
   private:
-    std::variant<callback, node_container> m_container;
+    /**
+     * Returns the AST nodes of an scripted quote, parsing them first if
+     * parsing has been deferred.
+     */
+    const node_container& body() const;
+
+    /**
+     * Executes the AST nodes of an scripted quote.
+     */
+    void execute(class context& context, std::ostream* out) const;
+
+  private:
+    std::variant<callback, native, node_container> m_container;
+    std::shared_ptr<std::optional<node_container>> m_compiled;
+    /** Whether the quote declares local variables. */
+    bool m_scoped;
+    /** Activation frame of the lexically enclosing quote, if any. */
+    std::shared_ptr<class frame> m_frame;
+    /** Source code of the quote, if parsing it has been deferred. */
+    std::shared_ptr<deferred> m_deferred;
   };
 }
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace laskin
+{
+  /**
+   * Pseudorandom number generator implementing the xoshiro256** algorithm.
+   * Unless seeded explicitly, the generator seeds itself from
+   * `std::random_device` when it's used for the first time.
+   */
+  class random_generator
+  {
+  public:
+    using result_type = std::uint64_t;
+
+    explicit random_generator();
+
+    /**
+     * Resets state of the generator from given seed. Generators seeded with
+     * the same value produce identical sequences.
+     */
+    void seed(std::uint64_t seed);
+
+    /**
+     * Returns the next 64 bits from the generator.
+     */
+    result_type next();
+
+    /**
+     * Returns an double uniformly distributed in range [0, 1).
+     */
+    double uniform();
+
+    /**
+     * Fills given array with doubles uniformly distributed in range [0, 1).
+     * The doubles are identical to those returned by the same number of
+     * `uniform()` calls.
+     */
+    void uniform(double* output, std::size_t count);
+
+    /**
+     * Returns an integer uniformly distributed in range [min, max].
+     */
+    long integer(long min, long max);
+
+    /**
+     * Returns an double from normal distribution with mean of zero and
+     * standard deviation of one.
+     */
+    double normal();
+
+    /**
+     * Advances the generator as if `next()` had been called 2^128 times.
+     * Jumping an copy of an generator gives an stream that does not overlap
+     * with the original one, so that parallel workers can be given streams of
+     * their own.
+     */
+    void jump();
+
+  private:
+    void ensure_seeded();
+
+  private:
+    std::uint64_t m_state[4];
+    bool m_seeded;
+  };
+}
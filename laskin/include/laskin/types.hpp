@@ -34,6 +34,7 @@
 
 namespace laskin
 {
+  class big_integer;
   class context;
   class node;
   class quote;
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "laskin/types.hpp"
+
+/**
+ * Registry of measurement units, which identifies each unit with an small
+ * integer so that unit checks can be done without comparing unit symbols.
+ * The registry is shared by all threads and identifiers never change once
+ * they have been assigned, so they can be stored in values that are passed
+ * between threads.
+ */
+namespace laskin::units
+{
+  /** Identifier of an measurement unit. */
+  using id = std::uint16_t;
+
+  /** Identifier used for numbers without measurement unit. */
+  constexpr id none = 0;
+
+  // Time units have fixed identifiers, as dates and times can be offset with
+  // numbers that have them.
+  constexpr id second = 1;
+  constexpr id minute = 2;
+  constexpr id hour = 3;
+  constexpr id day = 4;
+
+  /** Dimension of an measurement unit, such as length or mass. */
+  using dimension_type = enum number::unit::type;
+
+  /**
+   * Describes how numbers with two different measurement units are converted
+   * into the common unit that arithmetic between them results in.
+   */
+  struct conversion
+  {
+    /** The common measurement unit. */
+    id unit;
+    /** Multiplier which converts the first unit into the common one. */
+    double first;
+    /** Multiplier which converts the second unit into the common one. */
+    double second;
+  };
+
+  /**
+   * Returns identifier of the measurement unit that has given symbol, or
+   * `none` if there is no such unit. Symbols not seen before are resolved
+   * through the arbitrary precision number parser, once per thread for
+   * those that turn out to be units.
+   */
+  id find(const std::u32string& symbol);
+
+  /**
+   * Returns identifier of the measurement unit of given number, or `none` if
+   * the number has no measurement unit. The unit symbol is looked up on
+   * every call, so `value::unit_id()`, which remembers the result, should be
+   * preferred when the number is held in an value.
+   */
+  id of(const number& number);
+
+  /**
+   * Returns the measurement unit with given identifier, or null pointer if
+   * there is no such unit.
+   */
+  const number::unit* get(id unit);
+
+  /**
+   * Returns number of seconds in one of given time unit, or zero if the unit
+   * is not an time unit that dates and times can be offset with.
+   */
+  long seconds(id unit);
+
+  /**
+   * Returns dimension of the measurement unit with given identifier, or
+   * nothing if there is no such unit.
+   */
+  std::optional<dimension_type> dimension(id unit);
+
+  /**
+   * Returns conversion of numbers with the two given measurement units into
+   * common unit, or nothing if the units do not share the same dimension.
+   * Conversions are computed with the arbitrary precision arithmetic when
+   * the pair of units is seen for the first time, and looked up from an
+   * table afterwards.
+   */
+  std::optional<conversion> convert(id first, id second);
+}
@@ -28,6 +28,7 @@
 #include <memory>
 
 #include "laskin/types.hpp"
+#include "laskin/units.hpp"
 
 namespace laskin
 {
@@ -54,11 +55,31 @@ namespace laskin
       weekday,
     };
 
+    /**
+     * Number of different supported value types.
+     */
+    static constexpr std::size_t type_count =
+      static_cast<std::size_t>(type::weekday) + 1;
+
     /**
      * Constructs number value by parsing number and unit from given string.
      */
     static value parse_number(const std::u32string& input);
 
+    /**
+     * Parses number and unit from given string into the result, without
+     * throwing exceptions. Returns boolean flag telling whether the string
+     * contained valid number.
+     */
+    static bool parse_number(const std::u32string& input, value& result);
+
+    /**
+     * Constructs number value that is stored as IEEE double. Real values are
+     * used for numbers without measurement unit when the context has been
+     * put into fast numeric mode.
+     */
+    static value real(double value);
+
     /**
      * Constructs boolean value of false.
      */
@@ -89,6 +110,12 @@ namespace laskin
      */
     value(double value);
 
+    /**
+     * Constructs numeric value from arbitrary precision integer. The integer
+     * is stored as machine integer if it fits into one.
+     */
+    value(const big_integer& value);
+
     /**
      * Constructs string.
      */
@@ -175,6 +202,11 @@ namespace laskin
      */
     value& assign(double value);
 
+    /**
+     * Assigns arbitrary precision integer into this value.
+     */
+    value& assign(const big_integer& value);
+
     /**
      * Assigns string into this value.
      */
@@ -265,6 +297,14 @@ namespace laskin
       return assign(value);
     }
 
+    /**
+     * Assigns arbitrary precision integer into this value.
+     */
+    inline value& operator=(const big_integer& value)
+    {
+      return assign(value);
+    }
+
     /**
      * Assigns string into this value.
      */
@@ -358,6 +398,81 @@ namespace laskin
       return m_type == type;
     }
 
+    /**
+     * Tests whether the value is an number that is stored as machine integer.
+     * Integer values are used for whole numbers without measurement unit,
+     * and arithmetic on them is performed without going through arbitrary
+     * precision numbers, as long as the result fits into long integer.
+     * Results of addition, substraction, multiplication, modulo and
+     * exponentiation that do not fit are promoted into big integers, which
+     * remain exact until they are divided or used together with fractional
+     * numbers.
+     */
+    inline bool is_integer() const
+    {
+      return m_type == type::number && m_integer;
+    }
+
+    /**
+     * Returns value of an integer value. Must only be called when
+     * `is_integer()` returns `true`.
+     */
+    inline long as_integer() const
+    {
+      return m_value_integer;
+    }
+
+    /**
+     * Tests whether the value is an number that is stored as arbitrary
+     * precision integer, because it does not fit into long integer.
+     */
+    inline bool is_big_integer() const
+    {
+      return m_type == type::number && m_big_integer;
+    }
+
+    /**
+     * Returns value of an big integer value. Must only be called when
+     * `is_big_integer()` returns `true`.
+     */
+    inline const big_integer& as_big_integer() const
+    {
+      return *m_value_big_integer;
+    }
+
+    /**
+     * Converts integer value, stored either as machine integer or as big
+     * integer, into big integer. Must only be called when either
+     * `is_integer()` or `is_big_integer()` returns `true`.
+     */
+    big_integer to_big_integer() const;
+
+    /**
+     * Tests whether the value is an number that is stored as IEEE double.
+     * Arithmetic between real value and another number without measurement
+     * unit produces real value.
+     */
+    inline bool is_real() const
+    {
+      return m_type == type::number && m_real;
+    }
+
+    /**
+     * Returns value of an real value. Must only be called when `is_real()`
+     * returns `true`.
+     */
+    inline double as_real() const
+    {
+      return m_value_real;
+    }
+
+    /**
+     * Returns identifier of the measurement unit of an numeric value. The
+     * identifier is looked up from the unit registry only once, after which
+     * it's kept with the value and copies of it.
+     */
+    units::id unit_id() const;
+
     /**
      * Returns textual description of a value type.
      */
@@ -520,11 +635,63 @@ namespace laskin
     }
 
   private:
+    /**
+     * Tests whether arithmetic between this number and given number should
+     * be performed with IEEE doubles, which is the case when either one of
+     * them is an real value and neither one has measurement unit.
+     */
+    bool is_real_operation(const value& that) const;
+
+    /**
+     * Tests whether arithmetic between this number and given number can be
+     * performed with big integers, which is the case when both of them are
+     * integers, stored either as machine integers or as big integers.
+     */
+    inline bool is_integer_operation(const value& that) const
+    {
+      return (m_integer || m_big_integer)
+        && (that.m_integer || that.m_big_integer);
+    }
+
+  private:
+    static constexpr units::id unresolved_unit = static_cast<units::id>(-1);
+
     /** Type of the value. */
     enum type m_type;
+    /**
+     * Whether numeric value is stored as machine integer. The integer gets
+     * converted into arbitrary precision number when one is requested.
+     */
+    bool m_integer = false;
+    /**
+     * Whether numeric value is stored as big integer. Big integers are also
+     * converted into arbitrary precision number when one is requested.
+     */
+    bool m_big_integer = false;
+    /**
+     * Whether numeric value is stored as IEEE double. Just like integers,
+     * the double gets converted into arbitrary precision number when one is
+     * requested.
+     */
+    bool m_real = false;
+    /**
+     * Identifier of the measurement unit of numeric value, or
+     * `unresolved_unit` if it has not been looked up yet.
+     */
+    mutable units::id m_unit_id = unresolved_unit;
+    /**
+     * Arbitrary precision number converted from machine integer, big
+     * integer or IEEE double when one was requested, or null pointer. The
+     * conversion does not replace the integer or double, which remains
+     * exact.
+     */
+    mutable number* m_converted_number = nullptr;
     union
     {
       bool m_value_boolean;
+      long m_value_integer;
+      double m_value_real;
+      big_integer* m_value_big_integer;
       number* m_value_number;
       vector* m_value_vector;
       std::u32string* m_value_string;
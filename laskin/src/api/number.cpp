@@ -25,11 +25,258 @@
  */
 #include <cmath>
 
+#include "laskin/big_integer.hpp"
 #include "laskin/context.hpp"
 #include "laskin/error.hpp"
+#include "laskin/integer.hpp"
+#include "laskin/numeric.hpp"
+#include "laskin/quantities.hpp"
 
 using namespace laskin;
 
+/**
+ * Tests whether given value is an number without measurement unit, which can
+ * be computed with IEEE doubles in fast numeric mode.
+ */
+static inline bool
+is_unitless(const value& value)
+{
+  return value.is_integer()
+    || value.is_big_integer()
+    || value.is_real()
+    || !value.as_number().measurement_unit();
+}
+
+/**
+ * Throws type error if given value is not an number. Unlike `as_number()`,
+ * this does not convert integers and doubles into arbitrary precision
+ * numbers, so they can still be compared as they are.
+ */
+static inline const value&
+expect_number(const value& value)
+{
+  if (!value.is(value::type::number))
+  {
+    throw error(
+      error::type::type,
+      U"Unexpected " +
+      value::type_description(value.type()) +
+      U"; Was excepting number."
+    );
+  }
+
+  return value;
+}
+
+using unary_method = number(*)(const number&);
+using unary_function = double(*)(double);
+using binary_method = number(*)(const number&, const number&);
+using binary_function = double(*)(double, double);
+
+/**
+ * Computes given function for the number. In fast numeric mode, numbers
+ * without measurement unit are computed with the C library instead of MPFR.
+ */
+static value
+apply(
+  const class context& context,
+  const value& value,
+  unary_method method,
+  unary_function function
+)
+{
+  if (context.numeric.is_fast() && is_unitless(value))
+  {
+    return value::real(function(static_cast<double>(value)));
+  }
+
+  return method(value.as_number());
+}
+
+/**
+ * Computes given function for the two numbers, with the C library in fast
+ * numeric mode when neither one of the numbers has measurement unit.
+ */
+static value
+apply(
+  const class context& context,
+  const value& a,
+  const value& b,
+  binary_method method,
+  binary_function function
+)
+{
+  if (context.numeric.is_fast() && is_unitless(a) && is_unitless(b))
+  {
+    const auto x = static_cast<double>(a);
+    const auto y = static_cast<double>(b);
+
+    return value::real(function(x, y));
+  }
+
+  return method(a.as_number(), b.as_number());
+}
+
+/**
+ * Extracts magnitudes of an vector of numbers without measurement unit, if
+ * the vector can be computed with the C library over dense array of doubles
+ * instead of element by element.
+ */
+static std::optional<quantities>
+extract_unitless(const class context& context, const vector& elements)
+{
+  if (context.numeric.is_fast())
+  {
+    auto dense = quantities::extract(elements);
+
+    if (dense && dense->unit == units::none)
+    {
+      dense->real = true;
+
+      return dense;
+    }
+  }
+
+  return std::nullopt;
+}
+
+/**
+ * Replaces the number on top of the stack with result of given function.
+ */
+static void
+unary(class context& context, unary_method method, unary_function function)
+{
+  const auto value = context.pop();
+
+  context << apply(context, value, method, function);
+}
+
+/**
+ * Replaces the vector on top of the stack with results of given function for
+ * each of it's elements.
+ */
+static void
+unary_vector(
+  class context& context,
+  unary_method method,
+  unary_function function
+)
+{
+  const auto elements = context.pop().as_vector();
+  vector result;
+
+  if (auto dense = extract_unitless(context, elements))
+  {
+    for (auto& magnitude : dense->magnitudes)
+    {
+      magnitude = function(magnitude);
+    }
+    context << dense->box();
+    return;
+  }
+  result.reserve(elements.size());
+  for (const auto& element : elements)
+  {
+    result.push_back(apply(context, element, method, function));
+  }
+  context << result;
+}
+
+/**
+ * Replaces the two topmost numbers of the stack with result of given
+ * function.
+ */
+static void
+binary(class context& context, binary_method method, binary_function function)
+{
+  const auto a = context.pop();
+  const auto b = context.pop();
+
+  context << apply(context, a, b, method, function);
+}
+
+/**
+ * Replaces the vector on top of the stack and the number below it with
+ * results of given function for each element of the vector, with the number
+ * as second argument. Elements that cannot be computed over dense array of
+ * doubles are computed with `element`, if one is given.
+ */
+static void
+binary_vector(
+  class context& context,
+  binary_method method,
+  binary_function function,
+  value (*element)(const class context&, const value&, const value&) = nullptr
+)
+{
+  const auto elements = context.pop().as_vector();
+  const auto operand = context.pop();
+  vector result;
+
+  if (auto dense = extract_unitless(context, elements))
+  {
+    // Integer operands are left for `element`, which may compute results
+    // for integer elements exactly, as `power()` does.
+    if (is_unitless(operand) && !(element && operand.is_integer()))
+    {
+      const auto y = static_cast<double>(operand);
+
+      for (auto& magnitude : dense->magnitudes)
+      {
+        magnitude = function(magnitude, y);
+      }
+      context << dense->box();
+      return;
+    }
+  }
+  result.reserve(elements.size());
+  for (const auto& x : elements)
+  {
+    result.push_back(
+      element
+        ? element(context, x, operand)
+        : apply(context, x, operand, method, function)
+    );
+  }
+  context << result;
+}
+
+#define LASKIN_MATH_WORD(name) \
+  static number name##_method(const number& x) \
+  { \
+    return x.name(); \
+  } \
+  static double name##_function(double x) \
+  { \
+    return std::name(x); \
+  } \
+  LASKIN_BUILTIN_WORD(w_##name) \
+  { \
+    unary(context, name##_method, name##_function); \
+  } \
+  LASKIN_BUILTIN_WORD(w_vector_##name) \
+  { \
+    unary_vector(context, name##_method, name##_function); \
+  }
+
+#define LASKIN_MATH_WORD2(name) \
+  static number name##_method(const number& x, const number& y) \
+  { \
+    return x.name(y); \
+  } \
+  static double name##_function(double x, double y) \
+  { \
+    return std::name(x, y); \
+  } \
+  LASKIN_BUILTIN_WORD(w_##name) \
+  { \
+    binary(context, name##_method, name##_function); \
+  } \
+  LASKIN_BUILTIN_WORD(w_vector_##name) \
+  { \
+    binary_vector(context, name##_method, name##_function); \
+  }
+
 /**
  * pi ( -- number )
  *
@@ -37,7 +284,7 @@ using namespace laskin;
  */
 LASKIN_BUILTIN_WORD(w_pi)
 {
-  context << M_PI;
+  context << context.numeric.coerce(M_PI);
 }
 
 /**
@@ -47,7 +294,7 @@ LASKIN_BUILTIN_WORD(w_pi)
  */
 LASKIN_BUILTIN_WORD(w_e)
 {
-  context << M_E;
+  context << context.numeric.coerce(M_E);
 }
 
 /**
@@ -193,6 +440,28 @@ LASKIN_BUILTIN_WORD(w_clamp)
   context << (value > max ? max : value < min ? min : value);
 }
 
+/**
+ * vector:clamp ( number number vector -- vector )
+ *
+ * Ensures that each number of the vector is between given minimum and
+ * maximum boundaries.
+ */
+LASKIN_BUILTIN_WORD(w_vector_clamp)
+{
+  const auto elements = context.pop().as_vector();
+  const auto max = expect_number(context.pop());
+  const auto min = expect_number(context.pop());
+  vector result;
+
+  result.reserve(elements.size());
+  for (const auto& element : elements)
+  {
+    expect_number(element);
+    result.push_back(element > max ? max : element < min ? min : element);
+  }
+  context << result;
+}
+
 /**
  * number:times ( quote number -- )
  *
@@ -215,28 +484,31 @@ LASKIN_BUILTIN_WORD(w_times)
 }
 
 /**
- * number:ceil ( number -- number )
+ * number:precision ( number -- )
  *
- * Rounds the number to the next higher or equal representable integer.
+ * Sets the precision, in bits, of arbitrary precision numbers created after
+ * this. The precision is shared by all contexts of the current thread.
+ *
+ * Range error will be thrown if the precision is not supported.
  */
-LASKIN_BUILTIN_WORD(w_ceil)
+LASKIN_BUILTIN_WORD(w_precision)
 {
-  number n;
-
-  context >> n << n.ceil();
+  numeric::set_precision(long(context.pop()));
 }
 
+/**
+ * number:ceil ( number -- number )
+ *
+ * Rounds the number to the next higher or equal representable integer.
+ */
+LASKIN_MATH_WORD(ceil)
+
 /**
  * number:floor ( number -- number )
  *
  * Rounds the number to the next lower or equal representable integer.
  */
-LASKIN_BUILTIN_WORD(w_floor)
-{
-  number n;
-
-  context >> n << n.floor();
-}
+LASKIN_MATH_WORD(floor)
 
 /**
  * number:round ( number -- number )
@@ -244,154 +516,132 @@ LASKIN_BUILTIN_WORD(w_floor)
  * Rounds the number to the nearest representable integer, rounding halfway
  * cases away from zero.
  */
-LASKIN_BUILTIN_WORD(w_round)
-{
-  number n;
-
-  context >> n << n.round();
-}
+LASKIN_MATH_WORD(round)
 
-LASKIN_BUILTIN_WORD(w_exp)
-{
-  context << context.pop().as_number().exp();
-}
+LASKIN_MATH_WORD(exp)
+LASKIN_MATH_WORD(exp2)
+LASKIN_MATH_WORD(expm1)
+LASKIN_MATH_WORD(log)
+LASKIN_MATH_WORD(log10)
+LASKIN_MATH_WORD(log2)
+LASKIN_MATH_WORD(log1p)
 
-LASKIN_BUILTIN_WORD(w_exp2)
+static number
+pow_method(const number& x, const number& y)
 {
-  context << context.pop().as_number().exp2();
+  return x.pow(y);
 }
 
-LASKIN_BUILTIN_WORD(w_expm1)
+static double
+pow_function(double x, double y)
 {
-  context << context.pop().as_number().expm1();
+  return std::pow(x, y);
 }
 
-LASKIN_BUILTIN_WORD(w_log)
-{
-  context << context.pop().as_number().log();
-}
-
-LASKIN_BUILTIN_WORD(w_log10)
+/**
+ * Raises the first number into the power of the second one, using integer
+ * arithmetic when both of them are integers. Results that do not fit into
+ * long integer are computed with big integers, unless they would be too large
+ * for even those.
+ */
+static value
+power(const class context& context, const value& a, const value& b)
 {
-  context << context.pop().as_number().log10();
-}
+  long result;
+  big_integer big_result;
 
-LASKIN_BUILTIN_WORD(w_log2)
-{
-  context << context.pop().as_number().log2();
-}
+  if (
+    a.is_integer() &&
+    b.is_integer() &&
+    integer::power(a.as_integer(), b.as_integer(), result)
+  )
+  {
+    return result;
+  }
+  else if (
+    (a.is_integer() || a.is_big_integer()) &&
+    b.is_integer() &&
+    big_integer::power(a.to_big_integer(), b.as_integer(), big_result)
+  )
+  {
+    return big_result;
+  }
 
-LASKIN_BUILTIN_WORD(w_log1p)
-{
-  context << context.pop().as_number().log1p();
+  return apply(context, a, b, pow_method, pow_function);
 }
 
 LASKIN_BUILTIN_WORD(w_pow)
 {
-  const auto a = context.pop().as_number();
-  const auto b = context.pop().as_number();
-
-  context << a.pow(b);
-}
-
-LASKIN_BUILTIN_WORD(w_sqrt)
-{
-  context << context.pop().as_number().sqrt();
-}
-
-LASKIN_BUILTIN_WORD(w_cbrt)
-{
-  context << context.pop().as_number().cbrt();
-}
-
-LASKIN_BUILTIN_WORD(w_hypot)
-{
-  const auto a = context.pop().as_number();
-  const auto b = context.pop().as_number();
-
-  context << a.hypot(b);
-}
-
-LASKIN_BUILTIN_WORD(w_acos)
-{
-  context << context.pop().as_number().acos();
-}
-
-LASKIN_BUILTIN_WORD(w_asin)
-{
-  context << context.pop().as_number().asin();
-}
-
-LASKIN_BUILTIN_WORD(w_atan)
-{
-  context << context.pop().as_number().atan();
-}
-
-LASKIN_BUILTIN_WORD(w_atan2)
-{
-  const auto a = context.pop().as_number();
-  const auto b = context.pop().as_number();
+  const auto a = context.pop();
+  const auto b = context.pop();
 
-  context << a.atan2(b);
+  context << power(context, a, b);
 }
 
-LASKIN_BUILTIN_WORD(w_cos)
+LASKIN_BUILTIN_WORD(w_vector_pow)
 {
-  context << context.pop().as_number().cos();
+  binary_vector(context, pow_method, pow_function, power);
 }
 
-LASKIN_BUILTIN_WORD(w_sin)
-{
-  context << context.pop().as_number().sin();
-}
+LASKIN_MATH_WORD(sqrt)
+LASKIN_MATH_WORD(cbrt)
+LASKIN_MATH_WORD2(hypot)
+LASKIN_MATH_WORD(acos)
+LASKIN_MATH_WORD(asin)
+LASKIN_MATH_WORD(atan)
+LASKIN_MATH_WORD2(atan2)
+LASKIN_MATH_WORD(cos)
+LASKIN_MATH_WORD(sin)
+LASKIN_MATH_WORD(tan)
+LASKIN_MATH_WORD(sinh)
+LASKIN_MATH_WORD(cosh)
+LASKIN_MATH_WORD(tanh)
+LASKIN_MATH_WORD(asinh)
+LASKIN_MATH_WORD(acosh)
+LASKIN_MATH_WORD(atanh)
 
-LASKIN_BUILTIN_WORD(w_tan)
+static number
+deg_method(const number& x)
 {
-  context << context.pop().as_number().tan();
+  return x * 180 / M_PI;
 }
 
-LASKIN_BUILTIN_WORD(w_sinh)
+static double
+deg_function(double x)
 {
-  context << context.pop().as_number().sinh();
+  return x * 180 / M_PI;
 }
 
-LASKIN_BUILTIN_WORD(w_cosh)
+static number
+rad_method(const number& x)
 {
-  context << context.pop().as_number().cosh();
+  return x * M_PI / 180L;
 }
 
-LASKIN_BUILTIN_WORD(w_tanh)
+static double
+rad_function(double x)
 {
-  context << context.pop().as_number().tanh();
+  return x * M_PI / 180;
 }
 
-LASKIN_BUILTIN_WORD(w_asinh)
-{
-  context << context.pop().as_number().asinh();
-}
-
-LASKIN_BUILTIN_WORD(w_acosh)
+LASKIN_BUILTIN_WORD(w_deg)
 {
-  context << context.pop().as_number().acosh();
+  unary(context, deg_method, deg_function);
 }
 
-LASKIN_BUILTIN_WORD(w_atanh)
+LASKIN_BUILTIN_WORD(w_vector_deg)
 {
-  context << context.pop().as_number().atanh();
+  unary_vector(context, deg_method, deg_function);
 }
 
-LASKIN_BUILTIN_WORD(w_deg)
+LASKIN_BUILTIN_WORD(w_rad)
 {
-  const auto value = context.pop().as_number();
-
-  context << (value * 180 / M_PI);
+  unary(context, rad_method, rad_function);
 }
 
-LASKIN_BUILTIN_WORD(w_rad)
+LASKIN_BUILTIN_WORD(w_vector_rad)
 {
-  const auto value = context.pop().as_number();
-
-  context << (value * M_PI / 180L);
+  unary_vector(context, rad_method, rad_function);
 }
 
 /**
@@ -454,6 +704,7 @@ namespace laskin::api
     { U"number:range", w_range },
     { U"number:clamp", w_clamp },
     { U"number:times", w_times },
+    { U"number:precision", w_precision },
 
     // Rounding functions.
     { U"number:ceil", w_ceil },
@@ -496,6 +747,38 @@ namespace laskin::api
 
     // Conversions.
     { U"number:>month", w_to_month },
-    { U"number:>weekday", w_to_weekday }
+    { U"number:>weekday", w_to_weekday },
+
+    // Math functions broadcast over vectors of numbers.
+    { U"vector:clamp", w_vector_clamp },
+    { U"vector:ceil", w_vector_ceil },
+    { U"vector:floor", w_vector_floor },
+    { U"vector:round", w_vector_round },
+    { U"vector:exp", w_vector_exp },
+    { U"vector:exp2", w_vector_exp2 },
+    { U"vector:expm1", w_vector_expm1 },
+    { U"vector:log", w_vector_log },
+    { U"vector:log10", w_vector_log10 },
+    { U"vector:log2", w_vector_log2 },
+    { U"vector:log1p", w_vector_log1p },
+    { U"vector:pow", w_vector_pow },
+    { U"vector:sqrt", w_vector_sqrt },
+    { U"vector:cbrt", w_vector_cbrt },
+    { U"vector:hypot", w_vector_hypot },
+    { U"vector:acos", w_vector_acos },
+    { U"vector:asin", w_vector_asin },
+    { U"vector:atan", w_vector_atan },
+    { U"vector:atan2", w_vector_atan2 },
+    { U"vector:cos", w_vector_cos },
+    { U"vector:sin", w_vector_sin },
+    { U"vector:tan", w_vector_tan },
+    { U"vector:deg", w_vector_deg },
+    { U"vector:rad", w_vector_rad },
+    { U"vector:sinh", w_vector_sinh },
+    { U"vector:cosh", w_vector_cosh },
+    { U"vector:tanh", w_vector_tanh },
+    { U"vector:asinh", w_vector_asinh },
+    { U"vector:acosh", w_vector_acosh },
+    { U"vector:atanh", w_vector_atanh }
   };
 }
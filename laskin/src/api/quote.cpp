@@ -24,6 +24,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include "laskin/context.hpp"
+#include "laskin/effect.hpp"
+#include "laskin/error.hpp"
 
 using namespace laskin;
 
@@ -37,6 +39,27 @@ LASKIN_BUILTIN_WORD(w_call)
   context.pop().as_quote().call(context, out);
 }
 
+/**
+ * Appends nodes that call given quote into the container. Bodies of scripted
+ * quotes are spliced in directly, so that combinations of quotes run just as
+ * fast as an equivalent hand written quote would. Native quotes, and quotes
+ * that need an activation frame of their own for local variables, are called
+ * through `quote:call` instead.
+ */
+static void
+append_call(quote::node_container& nodes, const quote& q)
+{
+  if (q.is_native() || q.is_scoped())
+  {
+    nodes.push_back(std::make_shared<node::literal>(q));
+    nodes.push_back(node::symbol::intern(U"quote:call"));
+  } else {
+    const auto& body = q.nodes();
+
+    nodes.insert(std::end(nodes), std::begin(body), std::end(body));
+  }
+}
+
 /**
  * quote:compose ( quote quote -- quote )
  *
@@ -46,14 +69,11 @@ LASKIN_BUILTIN_WORD(w_compose)
 {
   const auto right = context.pop().as_quote();
   const auto left = context.pop().as_quote();
-  const auto call = std::make_shared<node::symbol>(U"quote:call");
+  quote::node_container nodes;
 
-  context << quote({
-    std::make_shared<node::literal>(left),
-    call,
-    std::make_shared<node::literal>(right),
-    call
-  });
+  append_call(nodes, left);
+  append_call(nodes, right);
+  context << quote(nodes);
 }
 
 /**
@@ -65,12 +85,11 @@ LASKIN_BUILTIN_WORD(w_curry)
 {
   const auto q = context.pop().as_quote();
   const auto argument = context.pop();
+  quote::node_container nodes;
 
-  context << quote({
-    std::make_shared<node::literal>(argument),
-    std::make_shared<node::literal>(q),
-    std::make_shared<node::symbol>(U"quote:call")
-  });
+  nodes.push_back(std::make_shared<node::literal>(argument));
+  append_call(nodes, q);
+  context << quote(nodes);
 }
 
 /**
@@ -81,12 +100,11 @@ LASKIN_BUILTIN_WORD(w_curry)
 LASKIN_BUILTIN_WORD(w_negate)
 {
   const auto q = context.pop().as_quote();
+  quote::node_container nodes;
 
-  context << quote({
-    std::make_shared<node::literal>(q),
-    std::make_shared<node::symbol>(U"quote:call"),
-    std::make_shared<node::symbol>(U"boolean:not")
-  });
+  append_call(nodes, q);
+  nodes.push_back(node::symbol::intern(U"boolean:not"));
+  context << quote(nodes);
 }
 
 /**
@@ -105,6 +123,26 @@ LASKIN_BUILTIN_WORD(w_dip)
   context << value;
 }
 
+/**
+ * quote:effect ( quote -- boolean|string )
+ *
+ * Infers stack effect of the quote without calling it and returns it as an
+ * string, such as `( number -- number )`. False is returned if the effect
+ * cannot be determined without calling the quote. If the quote is certain to
+ * fail with an error, that error is thrown instead.
+ */
+LASKIN_BUILTIN_WORD(w_effect)
+{
+  const auto quote = context.pop().as_quote();
+
+  if (const auto result = effect::infer(quote, context))
+  {
+    context << result->to_source();
+    return;
+  }
+  context << false;
+}
+
 namespace laskin::api
 {
   extern "C" const context::dictionary_definition quote =
@@ -113,6 +151,7 @@ namespace laskin::api
     { U"quote:compose", w_compose },
     { U"quote:curry", w_curry },
     { U"quote:negate", w_negate },
-    { U"quote:dip", w_dip }
+    { U"quote:dip", w_dip },
+    { U"quote:effect", w_effect }
   };
 }
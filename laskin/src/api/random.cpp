@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "laskin/context.hpp"
+#include "laskin/error.hpp"
+#include "laskin/quantities.hpp"
+#include "laskin/random.hpp"
+
+using namespace laskin;
+
+/**
+ * Converts double produced by the generator into an number, using native
+ * double when the context computes in fast mode.
+ */
+static inline value
+to_value(const class context& context, double value)
+{
+  if (context.numeric.is_fast())
+  {
+    return value::real(value);
+  }
+
+  return value;
+}
+
+/**
+ * Pops an non-negative count from the stack.
+ */
+static std::size_t
+pop_count(class context& context)
+{
+  const auto count = long(context.pop());
+
+  if (count < 0)
+  {
+    throw error(error::type::range, U"Count cannot be negative.");
+  }
+
+  return static_cast<std::size_t>(count);
+}
+
+/**
+ * random:seed ( number -- )
+ *
+ * Seeds the random number generator of the context, making the sequence of
+ * generated numbers reproducible.
+ *
+ * Range error is thrown if the seed is not an integer.
+ */
+LASKIN_BUILTIN_WORD(w_seed)
+{
+  const auto seed = context.pop();
+
+  if (!seed.is_integer())
+  {
+    const auto& number = seed.as_number();
+
+    if (number.measurement_unit() || !(number.round() == number))
+    {
+      throw error(error::type::range, U"Seed must be an integer.");
+    }
+  }
+  context.random.seed(static_cast<std::uint64_t>(long(seed)));
+}
+
+/**
+ * random:jump ( -- )
+ *
+ * Advances the random number generator by 2^128 steps. Contexts copied
+ * before an jump produce streams which do not overlap with each other.
+ */
+LASKIN_BUILTIN_WORD(w_jump)
+{
+  context.random.jump();
+}
+
+/**
+ * random:number ( -- number )
+ *
+ * Returns an random number from range [0, 1).
+ */
+LASKIN_BUILTIN_WORD(w_number)
+{
+  context << to_value(context, context.random.uniform());
+}
+
+/**
+ * random:integer ( number number -- number )
+ *
+ * Returns an random integer between given minimum and maximum, both
+ * inclusive.
+ */
+LASKIN_BUILTIN_WORD(w_integer)
+{
+  const auto max = long(context.pop());
+  const auto min = long(context.pop());
+
+  if (min > max)
+  {
+    throw error(
+      error::type::range,
+      U"Minimum cannot be greater than maximum."
+    );
+  }
+  context << value(context.random.integer(min, max));
+}
+
+/**
+ * random:normal ( number number -- number )
+ *
+ * Returns an random number from normal distribution with given mean and
+ * standard deviation.
+ */
+LASKIN_BUILTIN_WORD(w_normal)
+{
+  const auto stddev = double(context.pop());
+  const auto mean = double(context.pop());
+
+  context << to_value(context, mean + stddev * context.random.normal());
+}
+
+/**
+ * random:vector ( number -- vector )
+ *
+ * Returns vector of given number of random numbers from range [0, 1).
+ */
+LASKIN_BUILTIN_WORD(w_vector)
+{
+  quantities dense;
+
+  // The numbers are generated straight into dense array of doubles, and
+  // boxed into values only once all of them are there.
+  dense.magnitudes.resize(pop_count(context));
+  dense.real = context.numeric.is_fast();
+  context.random.uniform(dense.magnitudes.data(), dense.magnitudes.size());
+  context << dense.box();
+}
+
+/**
+ * Moves given number of randomly chosen elements into the beginning of the
+ * vector, using partial Fisher-Yates shuffle.
+ */
+static void
+shuffle(random_generator& random, vector& vec, std::size_t count)
+{
+  const auto size = vec.size();
+
+  for (std::size_t i = 0; i < count && i + 1 < size; ++i)
+  {
+    const auto j = random.integer(
+      static_cast<long>(i),
+      static_cast<long>(size - 1)
+    );
+
+    std::swap(vec[i], vec[static_cast<std::size_t>(j)]);
+  }
+}
+
+/**
+ * random:shuffle ( vector -- vector )
+ *
+ * Returns copy of the vector with elements in random order.
+ */
+LASKIN_BUILTIN_WORD(w_shuffle)
+{
+  auto vec = context.pop().as_vector();
+
+  shuffle(context.random, vec, vec.size());
+  context << vec;
+}
+
+/**
+ * random:sample ( number vector -- vector )
+ *
+ * Returns given number of randomly chosen elements from the vector, without
+ * replacement.
+ */
+LASKIN_BUILTIN_WORD(w_sample)
+{
+  auto vec = context.pop().as_vector();
+  const auto count = pop_count(context);
+
+  if (count > vec.size())
+  {
+    throw error(
+      error::type::range,
+      U"Cannot sample more elements than there are in the vector."
+    );
+  }
+  shuffle(context.random, vec, count);
+  vec.resize(count);
+  context << vec;
+}
+
+namespace laskin::api
+{
+  extern "C" const context::dictionary_definition random_api =
+  {
+    { U"random:seed", w_seed },
+    { U"random:jump", w_jump },
+
+    { U"random:number", w_number },
+    { U"random:integer", w_integer },
+    { U"random:normal", w_normal },
+    { U"random:vector", w_vector },
+
+    { U"random:shuffle", w_shuffle },
+    { U"random:sample", w_sample }
+  };
+}
@@ -25,6 +25,7 @@
  */
 #include "laskin/context.hpp"
 #include "laskin/error.hpp"
+#include "laskin/quicken.hpp"
 
 using namespace laskin;
 
@@ -103,13 +104,38 @@ LASKIN_BUILTIN_WORD(w_map)
 {
   const auto properties = context.pop().as_record();
   const auto quote = context.pop().as_quote();
+  std::optional<quicken::kernel> kernel;
   record new_properties;
 
+  // Binary operators with an operand, such as `( 2 * )`, leave the name
+  // untouched, so they can be applied to the value alone.
+  if (!properties.empty())
+  {
+    kernel = quicken::kernel::match(
+      quote,
+      context,
+      std::begin(properties)->second
+    );
+    if (kernel && (!kernel->operand() || !kernel->is_binary()))
+    {
+      kernel.reset();
+    }
+  }
+
   for (const auto& property : properties)
   {
     std::u32string key;
     class value value;
 
+    if (kernel)
+    {
+      new_properties[property.first] = (*kernel)(
+        context,
+        out,
+        property.second
+      );
+      continue;
+    }
     context << property.first << property.second;
     quote.call(context, out);
     value = context.pop();
@@ -31,6 +31,7 @@
 
 #include "laskin/context.hpp"
 #include "laskin/error.hpp"
+#include "laskin/parse_cache.hpp"
 
 using namespace laskin;
 
@@ -733,7 +734,7 @@ LASKIN_BUILTIN_WORD(w_to_number)
 {
   const auto string = context.pop().as_string();
 
-  context << value::parse_number(string);
+  context << context.numeric.coerce(value::parse_number(string));
 }
 
 /**
@@ -745,7 +746,12 @@ LASKIN_BUILTIN_WORD(w_to_quote)
 {
   const auto source = context.pop().as_string();
 
-  context << quote::parse(source);
+  if (context.parse_cache)
+  {
+    context << context.parse_cache->parse(source);
+  } else {
+    context << quote::parse(source);
+  }
 }
 
 namespace laskin::api
@@ -118,7 +118,7 @@ LASKIN_BUILTIN_WORD(w_add)
   const auto b = context.pop();
   const auto a = context.pop();
 
-  context << a + b;
+  context << context.numeric.coerce(a + b);
 }
 
 /**
@@ -131,7 +131,7 @@ LASKIN_BUILTIN_WORD(w_sub)
   const auto b = context.pop();
   const auto a = context.pop();
 
-  context << a - b;
+  context << context.numeric.coerce(a - b);
 }
 
 /**
@@ -144,7 +144,7 @@ LASKIN_BUILTIN_WORD(w_mul)
   const auto b = context.pop();
   const auto a = context.pop();
 
-  context << a * b;
+  context << context.numeric.coerce(a * b);
 }
 
 /**
@@ -157,7 +157,7 @@ LASKIN_BUILTIN_WORD(w_div)
   const auto b = context.pop();
   const auto a = context.pop();
 
-  context << a / b;
+  context << context.numeric.coerce(a / b);
 }
 
 /**
@@ -170,7 +170,7 @@ LASKIN_BUILTIN_WORD(w_mod)
   const auto b = context.pop();
   const auto a = context.pop();
 
-  context << a % b;
+  context << context.numeric.coerce(a % b);
 }
 
 static inline void
@@ -482,7 +482,7 @@ LASKIN_BUILTIN_WORD(w_quit)
 }
 
 /**
- * if ( quote boolean -- )
+ * if ( boolean quote -- )
  *
  * Executes quote if given boolean value is true.
  */
@@ -498,7 +498,7 @@ LASKIN_BUILTIN_WORD(w_if)
 }
 
 /**
- * if-else ( quote quote boolean -- )
+ * if-else ( boolean quote quote -- )
  *
  * Executes first quote if given boolean value is true and the second one
  * otherwise.
@@ -604,7 +604,7 @@ LASKIN_BUILTIN_WORD(w_try_else)
  */
 LASKIN_BUILTIN_WORD(w_lookup)
 {
-  const auto& dictionary = context.dictionary;
+  const auto& dictionary = context.dictionary();
   const auto id = context.pop().as_string();
   const auto word = dictionary.find(id);
 
@@ -628,7 +628,7 @@ LASKIN_BUILTIN_WORD(w_define)
   const auto id = context.pop().as_string();
   const auto value = context.pop();
 
-  context.dictionary[id] = value;
+  context.define(id, value);
 }
 
 /**
@@ -641,13 +641,9 @@ LASKIN_BUILTIN_WORD(w_define)
 LASKIN_BUILTIN_WORD(w_delete)
 {
   const auto id = context.pop().as_string();
-  auto& dictionary = context.dictionary;
-  const auto i = dictionary.find(id);
 
-  if (i != std::end(dictionary))
+  if (!context.undefine(id))
   {
-    dictionary.erase(i);
-  } else {
     throw error(error::type::name, U"Unrecognized symbol: `" + id + U"'");
   }
 }
@@ -659,7 +655,7 @@ LASKIN_BUILTIN_WORD(w_delete)
  */
 LASKIN_BUILTIN_WORD(w_symbols)
 {
-  const auto& dictionary = context.dictionary;
+  const auto& dictionary = context.dictionary();
   vector result;
 
   result.reserve(dictionary.size());
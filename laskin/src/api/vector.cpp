@@ -23,8 +23,14 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
 #include "laskin/context.hpp"
 #include "laskin/error.hpp"
+#include "laskin/quantities.hpp"
+#include "laskin/quicken.hpp"
 
 using namespace laskin;
 
@@ -132,6 +138,16 @@ LASKIN_BUILTIN_WORD(w_mean)
   const auto vec = context.pop().as_vector();
   const auto size = vec.size();
 
+  if (const auto dense = quantities::extract(vec))
+  {
+    const auto mean = dense->sum() / static_cast<double>(size);
+
+    if (quantities::is_exact(mean))
+    {
+      context << dense->box(mean);
+      return;
+    }
+  }
   if (size > 0)
   {
     auto sum = vec[0].as_number();
@@ -159,6 +175,16 @@ LASKIN_BUILTIN_WORD(w_sum)
   const auto vec = context.pop().as_vector();
   const auto size = vec.size();
 
+  if (const auto dense = quantities::extract(vec))
+  {
+    const auto sum = dense->sum();
+
+    if (quantities::is_exact(sum))
+    {
+      context << dense->box(sum);
+      return;
+    }
+  }
   if (size > 0)
   {
     auto sum = vec[0].as_number();
@@ -174,6 +200,476 @@ LASKIN_BUILTIN_WORD(w_sum)
   throw error(error::type::range, U"Vector is empty.");
 }
 
+/**
+ * Interpolates linearly between two numbers.
+ */
+static inline double
+interpolate(double a, double b, double fraction)
+{
+  return a + (b - a) * fraction;
+}
+
+static inline value
+interpolate(const value& a, const value& b, double fraction)
+{
+  return a + (b - a) * value(fraction);
+}
+
+static inline double
+square_root(double x)
+{
+  return std::sqrt(x);
+}
+
+static inline value
+square_root(const value& x)
+{
+  if (x.is_real())
+  {
+    return value::real(std::sqrt(x.as_real()));
+  }
+
+  return x.as_number().sqrt();
+}
+
+/**
+ * Selects the element at given position, from 0 to 1, of the elements in
+ * sorted order, interpolating linearly between the two closest elements.
+ * Elements are partially reordered, but they are not sorted in full.
+ */
+template<class T>
+static T
+select(std::vector<T>& elements, double position)
+{
+  const auto rank = position * static_cast<double>(elements.size() - 1);
+  const auto index = static_cast<std::size_t>(rank);
+  const auto fraction = rank - static_cast<double>(index);
+  const auto begin = std::begin(elements);
+  const auto end = std::end(elements);
+  const auto nth = begin + index;
+
+  std::nth_element(begin, nth, end);
+  if (fraction == 0.0 || nth + 1 == end)
+  {
+    return *nth;
+  }
+
+  // After the selection, the element following the selected one in sorted
+  // order is the smallest one of those after it.
+  return interpolate(*nth, *std::min_element(nth + 1, end), fraction);
+}
+
+/**
+ * Summary statistics of numbers. Variance is the population variance.
+ */
+template<class T>
+struct summary
+{
+  T mean;
+  T variance;
+  T deviation;
+  T min;
+  T max;
+};
+
+/**
+ * Computes mean, variance and extremes of the elements in single pass, using
+ * Welford's algorithm.
+ */
+template<class T>
+static summary<T>
+summarize(const std::vector<T>& elements)
+{
+  const auto size = elements.size();
+  auto mean = elements[0];
+  auto min = mean;
+  auto max = mean;
+  T m2(0);
+
+  for (std::size_t i = 1; i < size; ++i)
+  {
+    const auto& x = elements[i];
+    const auto delta = x - mean;
+
+    mean = mean + delta / T(static_cast<long>(i + 1));
+    m2 = m2 + delta * (x - mean);
+    if (x < min)
+    {
+      min = x;
+    }
+    else if (x > max)
+    {
+      max = x;
+    }
+  }
+
+  const auto variance = m2 / T(static_cast<long>(size));
+
+  return { mean, variance, square_root(variance), min, max };
+}
+
+/**
+ * Distributes the elements into given number of equally wide bins between
+ * the smallest and largest element, and returns the number of elements in
+ * each bin.
+ */
+template<class T>
+static vector
+histogram(const std::vector<T>& elements, std::size_t bins)
+{
+  const auto extremes = std::minmax_element(
+    std::begin(elements),
+    std::end(elements)
+  );
+  const auto& min = *extremes.first;
+  const auto& max = *extremes.second;
+  const auto width = max - min;
+  std::vector<long> counts(bins, 0);
+
+  for (const auto& x : elements)
+  {
+    std::size_t index = 0;
+
+    if (max > min)
+    {
+      index = static_cast<std::size_t>(
+        static_cast<double>((x - min) / width) * static_cast<double>(bins)
+      );
+      if (index >= bins)
+      {
+        index = bins - 1;
+      }
+    }
+    ++counts[index];
+  }
+
+  return vector(std::begin(counts), std::end(counts));
+}
+
+/**
+ * Tests whether given number is neither infinite nor NaN.
+ */
+static bool
+is_finite(const value& value)
+{
+  if (value.is_integer())
+  {
+    return true;
+  }
+  else if (value.is_real())
+  {
+    return std::isfinite(value.as_real());
+  }
+
+  const auto& number = value.as_number();
+
+  return !number.is_inf() && !number.is_nan();
+}
+
+/**
+ * Expresses numbers of the vector as unitless numbers in the measurement unit
+ * of the first number, so that statistics can be computed from them with
+ * arbitrary precision. One of the measurement unit is stored into `unit`, if
+ * the numbers have one.
+ */
+static vector
+unitless(const vector& vec, std::optional<value>& unit)
+{
+  vector result;
+
+  if (vec.empty())
+  {
+    throw error(error::type::range, U"Vector is empty.");
+  }
+  else if (vec[0].is(value::type::number)
+      && !vec[0].is_integer()
+      && !vec[0].is_real())
+  {
+    if (const auto& measurement_unit = vec[0].as_number().measurement_unit())
+    {
+      unit = value(number(1.0, *measurement_unit));
+    }
+  }
+  result.reserve(vec.size());
+  for (const auto& element : vec)
+  {
+    // Infinities cannot be placed into bins, and NaN cannot be ordered for
+    // selection of percentiles.
+    if (!is_finite(element))
+    {
+      throw error(
+        error::type::range,
+        U"Vector contains infinite or NaN number."
+      );
+    }
+    result.push_back(unit ? element / *unit : element);
+  }
+
+  return result;
+}
+
+/**
+ * Converts unitless number back into the measurement unit given to
+ * `unitless()`.
+ */
+static inline value
+with_unit(const value& value, const std::optional<class value>& unit)
+{
+  return unit ? value * *unit : value;
+}
+
+/**
+ * Selects number from given position, from 0 to 1, of the vector in sorted
+ * order.
+ */
+static value
+percentile(const class context& context, const vector& vec, double position)
+{
+  std::optional<value> unit;
+
+  if (auto dense = quantities::extract(vec))
+  {
+    const auto magnitude = select(dense->magnitudes, position);
+
+    if (quantities::is_exact(magnitude))
+    {
+      return context.numeric.coerce(dense->box(magnitude));
+    }
+  }
+
+  auto elements = unitless(vec, unit);
+
+  return context.numeric.coerce(with_unit(select(elements, position), unit));
+}
+
+/**
+ * Computes summary statistics of the dense magnitudes, unless some of them
+ * cannot be represented exactly as doubles, in which case they have to be
+ * computed with arbitrary precision instead.
+ */
+static std::optional<summary<value>>
+summarize(const class context& context, const quantities& dense)
+{
+  const auto& numeric = context.numeric;
+  const auto result = summarize(dense.magnitudes);
+
+  if (
+    !quantities::is_exact(result.mean) ||
+    !quantities::is_exact(result.variance) ||
+    !quantities::is_exact(result.deviation)
+  )
+  {
+    return std::nullopt;
+  }
+
+  return summary<value>{
+    numeric.coerce(dense.box(result.mean)),
+    numeric.coerce(
+      dense.real ? value::real(result.variance) : value(result.variance)
+    ),
+    numeric.coerce(dense.box(result.deviation)),
+    numeric.coerce(dense.box(result.min)),
+    numeric.coerce(dense.box(result.max)),
+  };
+}
+
+/**
+ * Computes summary statistics of the vector. Variance is returned without
+ * measurement unit, as squared units cannot be represented. Dense magnitudes
+ * of the vector are used when given.
+ */
+static summary<value>
+summarize(
+  const class context& context,
+  const vector& vec,
+  const std::optional<quantities>& dense
+)
+{
+  const auto& numeric = context.numeric;
+  std::optional<value> unit;
+
+  if (dense)
+  {
+    if (const auto result = summarize(context, *dense))
+    {
+      return *result;
+    }
+  }
+
+  const auto result = summarize(unitless(vec, unit));
+
+  return {
+    numeric.coerce(with_unit(result.mean, unit)),
+    numeric.coerce(result.variance),
+    numeric.coerce(with_unit(result.deviation, unit)),
+    numeric.coerce(with_unit(result.min, unit)),
+    numeric.coerce(with_unit(result.max, unit)),
+  };
+}
+
+static inline summary<value>
+summarize(const class context& context, const vector& vec)
+{
+  return summarize(context, vec, quantities::extract(vec, true));
+}
+
+/**
+ * vector:median ( vector -- any )
+ *
+ * Returns the median of numbers in the vector. If the vector has even number
+ * of elements, the mean of the two middle ones is returned.
+ *
+ * Range error is thrown if the vector is empty or if it contains infinite
+ * or NaN numbers.
+ */
+LASKIN_BUILTIN_WORD(w_median)
+{
+  const auto vec = context.pop().as_vector();
+
+  context << percentile(context, vec, 0.5);
+}
+
+/**
+ * vector:percentile ( number vector -- any )
+ *
+ * Returns given percentile, from 0 to 100, of numbers in the vector,
+ * interpolating linearly between the closest numbers.
+ *
+ * Range error is thrown if the vector is empty or if it contains infinite
+ * or NaN numbers.
+ */
+LASKIN_BUILTIN_WORD(w_percentile)
+{
+  const auto vec = context.pop().as_vector();
+  const auto percentile = double(context.pop());
+
+  if (!(percentile >= 0.0 && percentile <= 100.0))
+  {
+    throw error(error::type::range, U"Percentile is out of range.");
+  }
+  context << ::percentile(context, vec, percentile / 100.0);
+}
+
+/**
+ * vector:variance ( vector -- number )
+ *
+ * Returns population variance of numbers in the vector. Measurement unit of
+ * the numbers is not included in the result.
+ *
+ * Range error is thrown if the vector is empty or if it contains infinite
+ * or NaN numbers.
+ */
+LASKIN_BUILTIN_WORD(w_variance)
+{
+  const auto vec = context.pop().as_vector();
+
+  context << summarize(context, vec).variance;
+}
+
+/**
+ * vector:stddev ( vector -- number )
+ *
+ * Returns population standard deviation of numbers in the vector.
+ *
+ * Range error is thrown if the vector is empty or if it contains infinite
+ * or NaN numbers.
+ */
+LASKIN_BUILTIN_WORD(w_stddev)
+{
+  const auto vec = context.pop().as_vector();
+
+  context << summarize(context, vec).deviation;
+}
+
+/**
+ * vector:histogram ( number vector -- vector )
+ *
+ * Divides range from the smallest to the largest number of the vector into
+ * given number of equally wide bins, and returns vector containing number of
+ * elements in each bin. The largest number is counted into the last bin.
+ *
+ * Range error is thrown if the vector is empty or if it contains infinite
+ * or NaN numbers.
+ */
+LASKIN_BUILTIN_WORD(w_histogram)
+{
+  const auto vec = context.pop().as_vector();
+  const auto bins = long(context.pop());
+  std::optional<value> unit;
+
+  if (bins < 1)
+  {
+    throw error(error::type::range, U"Number of bins must be positive.");
+  }
+  else if (const auto dense = quantities::extract(vec, true))
+  {
+    context << histogram(dense->magnitudes, static_cast<std::size_t>(bins));
+    return;
+  }
+  context << histogram(unitless(vec, unit), static_cast<std::size_t>(bins));
+}
+
+/**
+ * vector:describe ( vector -- record )
+ *
+ * Returns record containing number of elements, mean, standard deviation,
+ * smallest and largest number, median and the 25th and 75th percentile of
+ * numbers in the vector.
+ *
+ * Range error is thrown if the vector is empty or if it contains infinite
+ * or NaN numbers.
+ */
+LASKIN_BUILTIN_WORD(w_describe)
+{
+  const auto vec = context.pop().as_vector();
+  const auto& numeric = context.numeric;
+  static const struct
+  {
+    const char32_t* name;
+    double position;
+  } percentiles[] =
+  {
+    { U"p25", 0.25 },
+    { U"median", 0.5 },
+    { U"p75", 0.75 },
+  };
+  auto dense = quantities::extract(vec, true);
+  const auto summary = summarize(context, vec, dense);
+  std::optional<vector> elements;
+  std::optional<value> unit;
+  record result;
+
+  result[U"count"] = static_cast<long>(vec.size());
+  result[U"mean"] = summary.mean;
+  result[U"stddev"] = summary.deviation;
+  result[U"min"] = summary.min;
+  // The magnitudes are no longer needed in their original order, so they
+  // can be partially reordered by the selection. Percentiles that cannot be
+  // represented exactly as doubles are selected with arbitrary precision.
+  for (const auto& percentile : percentiles)
+  {
+    if (dense)
+    {
+      const auto magnitude = select(dense->magnitudes, percentile.position);
+
+      if (quantities::is_exact(magnitude))
+      {
+        result[percentile.name] = numeric.coerce(dense->box(magnitude));
+        continue;
+      }
+    }
+    if (!elements)
+    {
+      elements = unitless(vec, unit);
+    }
+    result[percentile.name] = numeric.coerce(
+      with_unit(select(*elements, percentile.position), unit)
+    );
+  }
+  result[U"max"] = summary.max;
+  context << result;
+}
+
 /**
  * vector:for-each ( quote vector -- )
  *
@@ -201,11 +697,21 @@ LASKIN_BUILTIN_WORD(w_map)
 {
   const auto vec = context.pop().as_vector();
   const auto quote = context.pop().as_quote();
+  std::optional<quicken::kernel> kernel;
   vector result;
 
   result.reserve(vec.size());
+  if (!vec.empty())
+  {
+    kernel = quicken::kernel::match(quote, context, vec[0]);
+  }
   for (const auto& value : vec)
   {
+    if (kernel)
+    {
+      result.push_back((*kernel)(context, out, value));
+      continue;
+    }
     context.push(value);
     quote.call(context, out);
     result.push_back(context.pop());
@@ -224,13 +730,26 @@ LASKIN_BUILTIN_WORD(w_filter)
 {
   const auto vec = context.pop().as_vector();
   const auto quote = context.pop().as_quote();
+  std::optional<quicken::kernel> kernel;
   vector result;
 
+  if (!vec.empty())
+  {
+    kernel = quicken::kernel::match(quote, context, vec[0]);
+  }
   for (const auto& value : vec)
   {
-    context.push(value);
-    quote.call(context, out);
-    if (context.pop().as_boolean())
+    bool keep;
+
+    if (kernel)
+    {
+      keep = (*kernel)(context, out, value).as_boolean();
+    } else {
+      context.push(value);
+      quote.call(context, out);
+      keep = context.pop().as_boolean();
+    }
+    if (keep)
     {
       result.push_back(value);
     }
@@ -258,6 +777,18 @@ LASKIN_BUILTIN_WORD(w_reduce)
     throw error(error::type::range, U"Cannot reduce empty vector.");
   }
   result = vec[0];
+  if (size > 1)
+  {
+    if (const auto kernel = quicken::kernel::match(quote, context, vec[1]))
+    {
+      for (vector::size_type i = 1; i < size; ++i)
+      {
+        result = (*kernel)(context, out, result, vec[i]);
+      }
+      context << result;
+      return;
+    }
+  }
   for (vector::size_type i = 1; i < size; ++i)
   {
     context << result << vec[i];
@@ -530,6 +1061,14 @@ namespace laskin::api
     { U"vector:mean", w_mean },
     { U"vector:sum", w_sum },
 
+    // Statistics.
+    { U"vector:median", w_median },
+    { U"vector:percentile", w_percentile },
+    { U"vector:variance", w_variance },
+    { U"vector:stddev", w_stddev },
+    { U"vector:histogram", w_histogram },
+    { U"vector:describe", w_describe },
+
     // Iteration.
     { U"vector:for-each", w_for_each },
     { U"vector:map", w_map },
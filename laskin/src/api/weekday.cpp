@@ -89,7 +89,7 @@ LASKIN_BUILTIN_WORD(w_friday)
 }
 
 /**
- * saturday ( -- saturday )
+ * saturday ( -- weekday )
  *
  * Returns Saturday.
  */
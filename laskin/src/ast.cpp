@@ -23,12 +23,114 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 #include "laskin/context.hpp"
 #include "laskin/error.hpp"
+#include "laskin/quicken.hpp"
+#include "laskin/quote.hpp"
 #include "laskin/utils.hpp"
 
 namespace laskin
 {
+  /**
+   * Table of hash-consed keys. Keys are held through weak references, so that
+   * they are released along with the last node that uses them.
+   */
+  struct key_table
+  {
+    std::unordered_map<
+      std::u32string,
+      std::weak_ptr<const std::u32string>
+    > keys;
+    std::size_t sweep_threshold = 1024;
+
+    node::key_type find(const std::u32string& contents) const
+    {
+      const auto entry = keys.find(contents);
+
+      return entry != std::end(keys) ? entry->second.lock() : nullptr;
+    }
+
+    void insert(const std::u32string& contents, const node::key_type& key)
+    {
+      keys[contents] = key;
+
+      // Drop keys of nodes that no longer exist, so that programs parsed at
+      // runtime do not grow the table without bounds.
+      if (keys.size() >= sweep_threshold)
+      {
+        for (auto it = std::begin(keys); it != std::end(keys);)
+        {
+          if (it->second.expired())
+          {
+            it = keys.erase(it);
+          } else {
+            ++it;
+          }
+        }
+        sweep_threshold = std::max<std::size_t>(1024, keys.size() * 2);
+      }
+    }
+  };
+
+  node::key_type
+  node::intern_key(const std::u32string& contents)
+  {
+    // Quotes may be passed between threads, so keys must be the same in all
+    // of them for the pointer comparison to work. Each thread looks up keys
+    // it has seen already from table of it's own, so that the lock of the
+    // shared table is only taken for contents new to the thread.
+    static std::mutex mutex;
+    static key_table shared;
+    static thread_local key_table local;
+    auto key = local.find(contents);
+
+    if (key)
+    {
+      return key;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      if (!(key = shared.find(contents)))
+      {
+        key = std::make_shared<const std::u32string>(contents);
+        shared.insert(contents, key);
+      }
+    }
+    local.insert(contents, key);
+
+    return key;
+  }
+
+  static node::key_type
+  literal_key(const value& value)
+  {
+    // Other values, numbers in particular, have multiple source
+    // representations of the same value, so they are compared by value.
+    if (value.is(value::type::string))
+    {
+      return node::intern_key(U"s" + value.as_string());
+    }
+    else if (value.is(value::type::boolean))
+    {
+      return node::intern_key(value.as_boolean() ? U"b1" : U"b0");
+    }
+
+    return nullptr;
+  }
+
+  node::literal::literal(
+    const class value& value_,
+    const std::optional<struct position>& position_
+  )
+    : node(position_)
+    , value(value_)
+    , m_key(literal_key(value_)) {}
+
   void
   node::literal::exec(
     class context& context,
@@ -43,7 +145,14 @@ namespace laskin
   {
     if (that && that->type() == type::literal)
     {
-      return value == std::static_pointer_cast<literal>(that)->value;
+      const auto t = std::static_pointer_cast<literal>(that);
+
+      if (m_key && t->m_key)
+      {
+        return m_key == t->m_key;
+      }
+
+      return value == t->value;
     }
 
     return false;
@@ -205,15 +314,149 @@ namespace laskin
     return result.append(1, U'}');
   }
 
+  /**
+   * How many times specialization of an symbol is allowed to be discarded
+   * because of an operand type mismatch before the symbol is left to use the
+   * generic implementation of the word.
+   */
+  static const int max_deoptimizations = 3;
+
+  /**
+   * Maximum number of nodes in compiled form of an scripted word for it to be
+   * inlined into the places where it's used.
+   */
+  static const std::size_t max_inline_size = 16;
+
+  /**
+   * Tests whether given scripted word is small enough to be inlined and does
+   * not refer to itself.
+   */
+  static bool
+  is_inlinable(const std::u32string& id, const quote& word)
+  {
+    if (
+      word.is_native() ||
+      word.is_scoped() ||
+      word.compiled()->size() > max_inline_size
+    )
+    {
+      return false;
+    }
+    for (const auto& node : word.nodes())
+    {
+      if (
+        node &&
+        node->type() == node::type::symbol &&
+        std::static_pointer_cast<node::symbol>(node)->id == id
+      )
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
   void
   node::symbol::exec(
     class context& context,
     std::ostream* out
   ) const
   {
+    if (m_handler)
+    {
+      if (m_generation == context.generation() && m_handler(context))
+      {
+        return;
+      }
+      m_handler = nullptr;
+      m_quickened = false;
+      ++m_deoptimizations;
+    }
+
+    if (!m_bound || m_generation != context.generation())
+    {
+      bind(context);
+    }
+
+    if (
+      !m_binding_type ||
+      (context && context.data.back().is(*m_binding_type))
+    )
+    {
+      if (const auto word = m_binding)
+      {
+        if (!m_quickened && m_deoptimizations < max_deoptimizations)
+        {
+          m_quickened = true;
+          if ((m_handler = quicken::find(word, context)))
+          {
+            m_handler(context);
+            return;
+          }
+        }
+        word(context, out);
+        return;
+      }
+      else if (m_body && !context.profiler)
+      {
+        // Hold on to the body, in case the word gets redefined while it's
+        // being executed.
+        const auto body = m_body;
+
+        for (const auto& node : *body)
+        {
+          if (node)
+          {
+            node->exec(context, out);
+          }
+        }
+        return;
+      }
+    }
+
     context.lookup(id, out, position);
   }
 
+  void
+  node::symbol::bind(const class context& context) const
+  {
+    auto word = context.resolve(id);
+
+    m_bound = true;
+    m_generation = context.generation();
+    m_binding_type.reset();
+    m_binding = nullptr;
+    m_body.reset();
+    m_quickened = false;
+    m_handler = nullptr;
+    m_deoptimizations = 0;
+
+    if (!word && context)
+    {
+      const auto type = context.data.back().type();
+
+      if ((word = context.resolve(id, type)))
+      {
+        m_binding_type = type;
+      }
+    }
+
+    if (word && word->is(value::type::quote))
+    {
+      const auto& quote = word->as_quote();
+
+      if (const auto target = quote.target())
+      {
+        m_binding = target;
+      }
+      else if (is_inlinable(id, quote))
+      {
+        m_body = quote.compiled();
+      }
+    }
+  }
+
   value
   node::symbol::eval(
     class context& context,
@@ -223,12 +466,29 @@ namespace laskin
     return context.eval(id, position);
   }
 
+  std::shared_ptr<node::symbol>
+  node::symbol::intern(const std::u32string& id)
+  {
+    static thread_local std::unordered_map<
+      std::u32string,
+      std::shared_ptr<symbol>
+    > table;
+    auto& entry = table[id];
+
+    if (!entry)
+    {
+      entry = std::make_shared<symbol>(id);
+    }
+
+    return entry;
+  }
+
   bool
   node::symbol::equals(const std::shared_ptr<node>& that) const
   {
     if (that && that->type() == type::symbol)
     {
-      return id == std::static_pointer_cast<symbol>(that)->id;
+      return m_key == std::static_pointer_cast<symbol>(that)->m_key;
     }
 
     return false;
@@ -240,7 +500,7 @@ namespace laskin
     std::ostream*
   ) const
   {
-    context.dictionary[id] = context.pop();
+    context.define(id, context.pop());
   }
 
   value
@@ -266,4 +526,381 @@ namespace laskin
 
     return false;
   }
+
+  void
+  node::binding::exec(
+    class context& context,
+    std::ostream*
+  ) const
+  {
+    if (!context.frame || context.frame->scope != scope)
+    {
+      context.frame = std::make_shared<frame>(scope, context.frame);
+    }
+    for (auto i = slots.size(); i > 0; --i)
+    {
+      context.frame->slots[slots[i - 1]] = context.pop();
+    }
+  }
+
+  value
+  node::binding::eval(
+    context&,
+    std::ostream*
+  ) const
+  {
+    throw error(
+      error::type::syntax,
+      U"Unable to evaluate declaration of local variables as expression.",
+      position
+    );
+  }
+
+  bool
+  node::binding::equals(const std::shared_ptr<node>& that) const
+  {
+    if (that && that->type() == type::binding)
+    {
+      const auto t = std::static_pointer_cast<binding>(that);
+      const auto size = slots.size();
+
+      if (t->slots.size() != size)
+      {
+        return false;
+      }
+      for (container_type::size_type i = 0; i < size; ++i)
+      {
+        if (scope->names[slots[i]] != t->scope->names[t->slots[i]])
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    return false;
+  }
+
+  std::u32string
+  node::binding::to_source() const
+  {
+    std::u32string result(U"-> (");
+
+    for (const auto slot : slots)
+    {
+      result += U' ';
+      result += scope->names[slot];
+    }
+    result += U" )";
+
+    return result;
+  }
+
+  /**
+   * Searches for the activation frame of given scope from the frame of the
+   * quote being executed and the frames of the quotes enclosing it.
+   */
+  static const value&
+  find_local(
+    const class context& context,
+    const node::local& local
+  )
+  {
+    for (auto f = context.frame.get(); f; f = f->parent.get())
+    {
+      if (f->scope == local.scope)
+      {
+        return f->slots[local.slot];
+      }
+    }
+
+    throw error(
+      error::type::name,
+      U"Local variable `" + local.id + U"' is not accessible.",
+      local.position
+    );
+  }
+
+  void
+  node::local::exec(
+    class context& context,
+    std::ostream* out
+  ) const
+  {
+    const auto& word = find_local(context, *this);
+
+    if (word.is(value::type::quote))
+    {
+      // Keep the quote alive even if the variable gets rebound by it.
+      const auto quote = word.as_quote();
+
+      quote.call(context, out);
+    } else {
+      context.data.push_back(word);
+    }
+  }
+
+  value
+  node::local::eval(
+    class context& context,
+    std::ostream*
+  ) const
+  {
+    return find_local(context, *this);
+  }
+
+  bool
+  node::local::equals(const std::shared_ptr<node>& that) const
+  {
+    if (that && that->type() == type::local)
+    {
+      return id == std::static_pointer_cast<local>(that)->id;
+    }
+
+    return false;
+  }
+
+  static void
+  collect_captures(
+    const std::shared_ptr<node>& node,
+    node::closure::capture_container& captures
+  )
+  {
+    if (!node)
+    {
+      return;
+    }
+    switch (node->type())
+    {
+      case node::type::local:
+        {
+          const auto local = std::static_pointer_cast<node::local>(node);
+
+          captures.push_back({ local->scope.get(), local->slot });
+        }
+        break;
+
+      case node::type::closure:
+        {
+          const auto& nested = std::static_pointer_cast<node::closure>(
+            node
+          )->captures;
+
+          captures.insert(
+            std::end(captures),
+            std::begin(nested),
+            std::end(nested)
+          );
+        }
+        break;
+
+      case node::type::vector_literal:
+        for (const auto& element :
+             std::static_pointer_cast<node::vector_literal>(node)->elements)
+        {
+          collect_captures(element, captures);
+        }
+        break;
+
+      case node::type::record_literal:
+        for (const auto& property :
+             std::static_pointer_cast<node::record_literal>(node)->properties)
+        {
+          collect_captures(property.second, captures);
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  static node::closure::capture_container
+  collect_captures(const class value& value)
+  {
+    node::closure::capture_container captures;
+
+    for (const auto& node : value.as_quote().nodes())
+    {
+      collect_captures(node, captures);
+    }
+
+    return captures;
+  }
+
+  node::closure::closure(
+    const class value& value_,
+    const std::optional<struct position>& position_
+  )
+    : node(position_)
+    , value(value_)
+    , captures(collect_captures(value_)) {}
+
+  void
+  node::closure::exec(
+    class context& context,
+    std::ostream* out
+  ) const
+  {
+    context.data.push_back(eval(context, out));
+  }
+
+  value
+  node::closure::eval(
+    class context& context,
+    std::ostream*
+  ) const
+  {
+    std::vector<const frame*> chain;
+    std::shared_ptr<frame> result;
+
+    for (auto f = context.frame.get(); f; f = f->parent.get())
+    {
+      chain.push_back(f);
+    }
+    // Copy the frames starting from the outermost one, so that the copies are
+    // chained in the same order as the originals.
+    for (auto i = chain.size(); i > 0; --i)
+    {
+      const auto original = chain[i - 1];
+      bool copied = false;
+
+      for (const auto& capture : captures)
+      {
+        if (capture.first != original->scope.get())
+        {
+          continue;
+        }
+        else if (!copied)
+        {
+          result = std::make_shared<frame>(original->scope, result);
+          copied = true;
+        }
+        result->slots[capture.second] = original->slots[capture.second];
+      }
+    }
+
+    return value.as_quote().bind(result);
+  }
+
+  bool
+  node::closure::equals(const std::shared_ptr<node>& that) const
+  {
+    if (that && that->type() == type::closure)
+    {
+      return value == std::static_pointer_cast<closure>(that)->value;
+    }
+
+    return false;
+  }
+
+  void
+  node::compiled::exec(
+    class context& context,
+    std::ostream* out
+  ) const
+  {
+    if (validate(context) && run(context, out))
+    {
+      return;
+    }
+    for (const auto& node : nodes)
+    {
+      if (node)
+      {
+        try
+        {
+          node->exec(context, out);
+        }
+        catch (const error& e)
+        {
+          throw error(
+            e.type,
+            e.message,
+            node->position ? node->position : e.position
+          );
+        }
+      }
+    }
+  }
+
+  value
+  node::compiled::eval(
+    class context&,
+    std::ostream*
+  ) const
+  {
+    throw error(
+      error::type::syntax,
+      U"Unable to evaluate `" + to_source() + U"' as expression.",
+      position
+    );
+  }
+
+  bool
+  node::compiled::equals(const std::shared_ptr<node>& that) const
+  {
+    return that.get() == this;
+  }
+
+  std::u32string
+  node::compiled::to_source() const
+  {
+    std::u32string result;
+    bool first = true;
+
+    for (const auto& node : nodes)
+    {
+      if (first)
+      {
+        first = false;
+      } else {
+        result.append(1, U' ');
+      }
+      if (node)
+      {
+        result.append(node->to_source());
+      }
+    }
+
+    return result;
+  }
+
+  bool
+  node::compiled::validate(const class context& context) const
+  {
+    const auto generation = context.generation();
+
+    if (m_validated && m_generation == generation)
+    {
+      return true;
+    }
+    for (const auto& guard : guards)
+    {
+      if (guard.word)
+      {
+        const auto word = guard.type
+          ? context.resolve(guard.id, *guard.type)
+          : context.resolve(guard.id);
+
+        if (
+          !word ||
+          !word->is(value::type::quote) ||
+          word->as_quote().target() != guard.word
+        )
+        {
+          return false;
+        }
+      }
+      else if (context.is_defined(guard.id))
+      {
+        return false;
+      }
+    }
+    m_validated = true;
+    m_generation = generation;
+
+    return true;
+  }
 }
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cstddef>
+
+#include "laskin/big_integer.hpp"
+
+namespace laskin
+{
+  /**
+   * Maximum number of bits in result of exponentiation, above which the
+   * result is computed with floating point numbers instead, as the exact
+   * result would take too long to compute and too much memory to hold.
+   */
+  static const std::size_t max_power_bits = 1 << 20;
+
+  big_integer::big_integer(long value)
+  {
+    mpz_init_set_si(m_value, value);
+  }
+
+  big_integer::big_integer(const big_integer& that)
+  {
+    mpz_init_set(m_value, that.m_value);
+  }
+
+  big_integer::big_integer(big_integer&& that)
+  {
+    mpz_init(m_value);
+    mpz_swap(m_value, that.m_value);
+  }
+
+  big_integer::~big_integer()
+  {
+    mpz_clear(m_value);
+  }
+
+  big_integer&
+  big_integer::operator=(const big_integer& that)
+  {
+    mpz_set(m_value, that.m_value);
+
+    return *this;
+  }
+
+  big_integer&
+  big_integer::operator=(big_integer&& that)
+  {
+    mpz_swap(m_value, that.m_value);
+
+    return *this;
+  }
+
+  bool
+  big_integer::parse(const std::string& input, big_integer& result)
+  {
+    const auto length = input.length();
+    std::size_t start = 0;
+
+    if (length > 0 && (input[0] == '+' || input[0] == '-'))
+    {
+      ++start;
+    }
+    if (start == length)
+    {
+      return false;
+    }
+    for (auto i = start; i < length; ++i)
+    {
+      if (input[i] < '0' || input[i] > '9')
+      {
+        return false;
+      }
+    }
+    mpz_set_str(result.m_value, input.c_str() + start, 10);
+    if (input[0] == '-')
+    {
+      mpz_neg(result.m_value, result.m_value);
+    }
+
+    return true;
+  }
+
+  bool
+  big_integer::power(
+    const big_integer& base,
+    long exponent,
+    big_integer& result
+  )
+  {
+    if (exponent < 0)
+    {
+      return false;
+    }
+    // Powers of zero and one, positive or negative, never grow.
+    else if (
+      mpz_cmpabs_ui(base.m_value, 1) > 0 &&
+      static_cast<unsigned long>(exponent) >
+        max_power_bits / mpz_sizeinbase(base.m_value, 2)
+    )
+    {
+      return false;
+    }
+    mpz_pow_ui(
+      result.m_value,
+      base.m_value,
+      static_cast<unsigned long>(exponent)
+    );
+
+    return true;
+  }
+
+  bool
+  big_integer::fits_long() const
+  {
+    return mpz_fits_slong_p(m_value);
+  }
+
+  long
+  big_integer::to_long() const
+  {
+    return mpz_get_si(m_value);
+  }
+
+  bool
+  big_integer::is_zero() const
+  {
+    return mpz_sgn(m_value) == 0;
+  }
+
+  std::string
+  big_integer::to_string() const
+  {
+    std::string result(mpz_sizeinbase(m_value, 10) + 2, '\0');
+
+    mpz_get_str(&result[0], 10, m_value);
+    result.resize(result.find('\0'));
+
+    return result;
+  }
+
+  int
+  big_integer::compare(const big_integer& that) const
+  {
+    const auto result = mpz_cmp(m_value, that.m_value);
+
+    return result > 0 ? 1 : result < 0 ? -1 : 0;
+  }
+
+  big_integer
+  big_integer::operator+(const big_integer& that) const
+  {
+    big_integer result;
+
+    mpz_add(result.m_value, m_value, that.m_value);
+
+    return result;
+  }
+
+  big_integer
+  big_integer::operator-(const big_integer& that) const
+  {
+    big_integer result;
+
+    mpz_sub(result.m_value, m_value, that.m_value);
+
+    return result;
+  }
+
+  big_integer
+  big_integer::operator*(const big_integer& that) const
+  {
+    big_integer result;
+
+    mpz_mul(result.m_value, m_value, that.m_value);
+
+    return result;
+  }
+
+  big_integer
+  big_integer::operator%(const big_integer& that) const
+  {
+    big_integer result;
+
+    mpz_tdiv_r(result.m_value, m_value, that.m_value);
+
+    return result;
+  }
+}
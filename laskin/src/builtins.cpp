@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "laskin/builtins.hpp"
+#include "laskin/context.hpp"
+
+namespace laskin::api
+{
+  extern "C" const context::dictionary_definition boolean;
+  extern "C" const context::dictionary_definition date;
+  extern "C" const context::dictionary_definition month;
+  extern "C" const context::dictionary_definition number;
+  extern "C" const context::dictionary_definition quote;
+  extern "C" const context::dictionary_definition random_api;
+  extern "C" const context::dictionary_definition record;
+  extern "C" const context::dictionary_definition string;
+  extern "C" const context::dictionary_definition time_api;
+  extern "C" const context::dictionary_definition utils;
+  extern "C" const context::dictionary_definition vector;
+  extern "C" const context::dictionary_definition weekday;
+}
+
+namespace laskin::builtins
+{
+  /**
+   * Minimal perfect hash table of builtin words, constructed with the "hash
+   * and displace" method. Each key is first hashed into an bucket, which stores
+   * an seed that places every key of the bucket into an unique slot. Lookups
+   * therefore cost two hash computations and a single string comparison,
+   * regardless of the contents of the table.
+   */
+  struct table
+  {
+    std::size_t mask;
+    std::vector<std::uint32_t> seeds;
+    std::vector<definition> slots;
+  };
+
+  static std::vector<definition>
+  collect_definitions()
+  {
+    static const context::dictionary_definition* apis[] =
+    {
+      &api::utils,
+      &api::boolean,
+      &api::date,
+      &api::month,
+      &api::number,
+      &api::quote,
+      &api::random_api,
+      &api::record,
+      &api::string,
+      &api::time_api,
+      &api::vector,
+      &api::weekday,
+    };
+    std::unordered_map<std::u32string_view, std::size_t> indexes;
+    std::vector<definition> result;
+
+    // Latter definitions override the former ones, just like they would when
+    // inserted into the dictionary one after another.
+    for (const auto api : apis)
+    {
+      for (const auto& word : *api)
+      {
+        const auto index = indexes.find(word.first);
+
+        if (index != std::end(indexes))
+        {
+          result[index->second].second = word.second;
+        } else {
+          indexes[word.first] = result.size();
+          result.push_back(word);
+        }
+      }
+    }
+
+    return result;
+  }
+
+  static bool
+  place_bucket(
+    struct table& table,
+    std::vector<bool>& taken,
+    const std::vector<definition>& bucket,
+    std::uint32_t seed
+  )
+  {
+    std::vector<std::size_t> slots;
+
+    for (const auto& word : bucket)
+    {
+      const auto slot = hash(word.first, seed) & table.mask;
+
+      if (
+        taken[slot] ||
+        std::find(std::begin(slots), std::end(slots), slot) != std::end(slots)
+      )
+      {
+        return false;
+      }
+      slots.push_back(slot);
+    }
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+      taken[slots[i]] = true;
+      table.slots[slots[i]] = bucket[i];
+    }
+
+    return true;
+  }
+
+  static struct table
+  build_table(const std::vector<definition>& definitions)
+  {
+    struct table table;
+    std::size_t size = 1;
+    std::vector<std::vector<definition>> buckets;
+    std::vector<std::size_t> order;
+    std::vector<bool> taken;
+
+    while (size < definitions.size())
+    {
+      size <<= 1;
+    }
+    table.mask = size - 1;
+    table.seeds.resize(size, 0);
+    table.slots.resize(size, definition(std::u32string_view(), nullptr));
+    buckets.resize(size);
+    taken.resize(size, false);
+
+    for (const auto& word : definitions)
+    {
+      buckets[hash(word.first, 0) & table.mask].push_back(word);
+    }
+
+    // Place the largest buckets first, while there are still plenty of free
+    // slots available.
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      order.push_back(i);
+    }
+    std::stable_sort(
+      std::begin(order),
+      std::end(order),
+      [&buckets](std::size_t a, std::size_t b)
+      {
+        return buckets[a].size() > buckets[b].size();
+      }
+    );
+
+    for (const auto index : order)
+    {
+      std::uint32_t seed = 1;
+
+      if (buckets[index].empty())
+      {
+        break;
+      }
+      while (!place_bucket(table, taken, buckets[index], seed))
+      {
+        if (++seed == UINT32_MAX)
+        {
+          throw std::logic_error("Unable to construct perfect hash table.");
+        }
+      }
+      table.seeds[index] = seed;
+    }
+
+    return table;
+  }
+
+  const std::vector<definition>&
+  all()
+  {
+    static const auto definitions = collect_definitions();
+
+    return definitions;
+  }
+
+  quote::native
+  find(std::u32string_view id)
+  {
+    static const auto table = build_table(all());
+    const auto seed = table.seeds[hash(id, 0) & table.mask];
+    const auto& slot = table.slots[hash(id, seed) & table.mask];
+
+    return slot.second && slot.first == id ? slot.second : nullptr;
+  }
+}
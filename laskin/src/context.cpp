@@ -23,35 +23,25 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <atomic>
 #include <fstream>
 
 #include <peelo/unicode/encoding/utf8.hpp>
 
+#include "laskin/builtins.hpp"
 #include "laskin/chrono.hpp"
 #include "laskin/context.hpp"
 #include "laskin/error.hpp"
+#include "laskin/parse_cache.hpp"
 
 namespace laskin
 {
-  static void initialize_dictionary(
-    context::dictionary_type&,
-    const context::dictionary_definition&
+  static std::optional<enum value::type> method_type(
+    const std::u32string&,
+    std::u32string&
   );
 
-  namespace api
-  {
-    extern "C" const context::dictionary_definition boolean;
-    extern "C" const context::dictionary_definition date;
-    extern "C" const context::dictionary_definition month;
-    extern "C" const context::dictionary_definition number;
-    extern "C" const context::dictionary_definition quote;
-    extern "C" const context::dictionary_definition record;
-    extern "C" const context::dictionary_definition string;
-    extern "C" const context::dictionary_definition time_api;
-    extern "C" const context::dictionary_definition utils;
-    extern "C" const context::dictionary_definition vector;
-    extern "C" const context::dictionary_definition weekday;
-  }
+  static std::uint64_t next_generation();
 
   context::context(
     const dictionary_default_callback& default_callback_,
@@ -59,18 +49,21 @@ namespace laskin
   )
     : default_callback(default_callback_)
     , allow_include(allow_include_)
+    , parse_cache(laskin::parse_cache::shared())
+    , m_generation(0)
   {
-    initialize_dictionary(dictionary, api::utils);
-    initialize_dictionary(dictionary, api::boolean);
-    initialize_dictionary(dictionary, api::date);
-    initialize_dictionary(dictionary, api::month);
-    initialize_dictionary(dictionary, api::number);
-    initialize_dictionary(dictionary, api::quote);
-    initialize_dictionary(dictionary, api::record);
-    initialize_dictionary(dictionary, api::string);
-    initialize_dictionary(dictionary, api::time_api);
-    initialize_dictionary(dictionary, api::vector);
-    initialize_dictionary(dictionary, api::weekday);
+    const auto& definitions = builtins::all();
+
+    m_dictionary.reserve(definitions.size());
+    for (const auto& word : definitions)
+    {
+      define(std::u32string(word.first), quote(word.second));
+    }
+
+    // Dictionaries of fresh contexts start out identical, but they may still
+    // resolve symbols differently, such as through different default
+    // callbacks, so caches validated in another context must not pass here.
+    m_generation = next_generation();
   }
 
   void
@@ -96,7 +89,10 @@ namespace laskin
         std::istreambuf_iterator<char>()
       );
       in.close();
-      run(source, out, path);
+      // Included files tend to be libraries of which only an fraction of the
+      // words are ever used, so parsing of quotes is deferred until they are
+      // actually needed.
+      quote::parse(source, path, 1, 0, true).call(*this, out);
     } else {
       throw error(
         error::type::system,
@@ -105,6 +101,101 @@ namespace laskin
     }
   }
 
+  void
+  context::define(const std::u32string& id, const class value& value)
+  {
+    const auto word = m_dictionary.find(id);
+    std::u32string name;
+
+    if (word == std::end(m_dictionary))
+    {
+      m_generation = next_generation();
+      m_dictionary.emplace(id, value);
+    } else {
+      // Replacing an variable with another value does not affect resolution
+      // of symbols, but anything involving an quote does.
+      if (word->second.is(value::type::quote) || value.is(value::type::quote))
+      {
+        m_generation = next_generation();
+      }
+      word->second = value;
+    }
+    if (const auto type = method_type(id, name))
+    {
+      m_methods[static_cast<std::size_t>(*type)][name] = value;
+    }
+  }
+
+  bool
+  context::undefine(const std::u32string& id)
+  {
+    const auto word = m_dictionary.find(id);
+    std::u32string name;
+
+    if (word == std::end(m_dictionary))
+    {
+      return false;
+    }
+    m_dictionary.erase(word);
+    m_generation = next_generation();
+    if (const auto type = method_type(id, name))
+    {
+      m_methods[static_cast<std::size_t>(*type)].erase(name);
+    }
+
+    return true;
+  }
+
+  bool
+  context::is_defined(const std::u32string& id) const
+  {
+    if (m_dictionary.find(id) != std::end(m_dictionary))
+    {
+      return true;
+    }
+    for (const auto& methods : m_methods)
+    {
+      if (methods.find(id) != std::end(methods))
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  const value*
+  context::resolve(const std::u32string& id) const
+  {
+    for (const auto& methods : m_methods)
+    {
+      if (methods.find(id) != std::end(methods))
+      {
+        return nullptr;
+      }
+    }
+
+    const auto word = m_dictionary.find(id);
+
+    return word != std::end(m_dictionary) ? &word->second : nullptr;
+  }
+
+  const value*
+  context::resolve(const std::u32string& id, enum value::type type) const
+  {
+    const auto& methods = m_methods[static_cast<std::size_t>(type)];
+    const auto method = methods.find(id);
+
+    if (method == std::end(methods))
+    {
+      const auto word = m_dictionary.find(id);
+
+      return word != std::end(m_dictionary) ? &word->second : nullptr;
+    }
+
+    return &method->second;
+  }
+
   void
   context::lookup(
     const std::u32string& id,
@@ -114,11 +205,12 @@ namespace laskin
   {
     if (!data.empty())
     {
-      const auto& value = data.back();
-      const auto type_id = value::type_description(value.type()) + U':' + id;
-      const auto word = dictionary.find(type_id);
+      const auto& methods = m_methods[
+        static_cast<std::size_t>(data.back().type())
+      ];
+      const auto word = methods.find(id);
 
-      if (word != std::end(dictionary))
+      if (word != std::end(methods))
       {
         if (word->second.is(value::type::quote))
         {
@@ -131,9 +223,9 @@ namespace laskin
     }
 
     {
-      const auto word = dictionary.find(id);
+      const auto word = m_dictionary.find(id);
 
-      if (word != std::end(dictionary))
+      if (word != std::end(m_dictionary))
       {
         if (word->second.is(value::type::quote))
         {
@@ -145,9 +237,9 @@ namespace laskin
       }
     }
 
-    if (number::is_valid(id))
+    if (value result; value::parse_number(id, result))
     {
-      data.push_back(value::parse_number(id));
+      data.push_back(numeric.coerce(std::move(result)));
       return;
     }
 
@@ -200,9 +292,9 @@ namespace laskin
       return pop();
     }
 
-    if (number::is_valid(id))
+    if (value result; value::parse_number(id, result))
     {
-      return value::parse_number(id);
+      return numeric.coerce(std::move(result));
     }
 
     if (is_date(id))
@@ -256,7 +348,7 @@ namespace laskin
   {
     if (!data.empty())
     {
-      const auto value = data.back();
+      auto value = std::move(data.back());
 
       data.pop_back();
 
@@ -276,15 +368,44 @@ namespace laskin
     return *this;
   }
 
-  static void
-  initialize_dictionary(
-    context::dictionary_type& dictionary,
-    const context::dictionary_definition& definition
-  )
+  /**
+   * Tests whether given word name is prefixed with name of an value type and
+   * if so, returns the value type and places name of the word without the
+   * prefix into given string.
+   */
+  static std::optional<enum value::type>
+  method_type(const std::u32string& id, std::u32string& name)
   {
-    for (const auto& word : definition)
+    const auto separator = id.find(U':');
+
+    if (separator == std::u32string::npos)
     {
-      dictionary[word.first] = word.second;
+      return std::nullopt;
     }
+    for (std::size_t i = 0; i < value::type_count; ++i)
+    {
+      const auto type = static_cast<enum value::type>(i);
+
+      if (!id.compare(0, separator, value::type_description(type)))
+      {
+        name = id.substr(separator + 1);
+
+        return type;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * Returns an dictionary generation that has not been used by any context
+   * before.
+   */
+  static std::uint64_t
+  next_generation()
+  {
+    static std::atomic<std::uint64_t> counter(0);
+
+    return ++counter;
   }
 }
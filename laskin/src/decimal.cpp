@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+#include "laskin/decimal.hpp"
+#include "laskin/integer.hpp"
+#include "laskin/numeric.hpp"
+#include "laskin/units.hpp"
+
+namespace laskin::decimal
+{
+  /**
+   * Maximum length of the numeric part of an number that is converted with
+   * `std::from_chars()`. Longer ones are left for the arbitrary precision
+   * parser.
+   */
+  static const std::size_t max_length = 64;
+
+  static inline bool
+  isdigit(char32_t c)
+  {
+    return c >= U'0' && c <= U'9';
+  }
+
+  errc
+  parse(const std::u32string& input, value& result)
+  {
+    const auto length = input.length();
+    std::u32string::size_type i = 0;
+    std::u32string::size_type start = 0;
+    const number::unit* unit = nullptr;
+    char buffer[max_length];
+    bool negative = false;
+    bool whole = true;
+    bool overflow = false;
+    long integer = 0;
+    double real;
+
+    if (i < length && (input[i] == U'-' || input[i] == U'+'))
+    {
+      negative = input[i] == U'-';
+      // `std::from_chars()` does not accept plus sign.
+      start = negative ? 0 : 1;
+      ++i;
+    }
+    // The integer part may be omitted, as in `.5`, as long as there is an
+    // fraction.
+    if (
+      i >= length ||
+      !(
+        isdigit(input[i]) ||
+        (input[i] == U'.' && i + 1 < length && isdigit(input[i + 1]))
+      )
+    )
+    {
+      return errc::invalid;
+    }
+    for (; i < length && isdigit(input[i]); ++i)
+    {
+      const auto digit = static_cast<long>(input[i] - U'0');
+
+      // Accumulate as negative number, as it has larger range than the
+      // positive one.
+      if (
+        !integer::multiply(integer, 10, integer) ||
+        !integer::substract(integer, digit, integer)
+      )
+      {
+        overflow = true;
+      }
+    }
+    if (i + 1 < length && input[i] == U'.' && isdigit(input[i + 1]))
+    {
+      whole = false;
+      ++i;
+      while (i < length && isdigit(input[i]))
+      {
+        ++i;
+      }
+    }
+    if (i + 1 < length && (input[i] == U'e' || input[i] == U'E'))
+    {
+      auto j = i + 1;
+
+      if (j + 1 < length && (input[j] == U'-' || input[j] == U'+'))
+      {
+        ++j;
+      }
+      if (isdigit(input[j]))
+      {
+        whole = false;
+        i = j;
+        while (i < length && isdigit(input[i]))
+        {
+          ++i;
+        }
+      }
+    }
+    if (i < length)
+    {
+      // Remainders of date and time literals, among others, cannot be units,
+      // so there's no point in asking the arbitrary precision parser.
+      if (
+        isdigit(input[i]) ||
+        input[i] == U'-' ||
+        input[i] == U'+' ||
+        input[i] == U'.' ||
+        input[i] == U':'
+      )
+      {
+        return errc::invalid;
+      }
+      else if (!(unit = units::get(units::find(input.substr(i)))))
+      {
+        return errc::unknown_unit;
+      }
+    }
+
+    if (whole && !unit)
+    {
+      // Integers that do not fit into long are left for the big integers.
+      if (overflow || (!negative && !integer::multiply(integer, -1, integer)))
+      {
+        return errc::out_of_range;
+      }
+      result = integer;
+
+      return errc::ok;
+    }
+    // Decimal string converted into double is correctly rounded, so it's
+    // identical to arbitrary precision number of the same precision.
+    if (
+      i - start > max_length ||
+      numeric::precision() != std::numeric_limits<double>::digits
+    )
+    {
+      return errc::out_of_range;
+    }
+    std::copy(
+      std::begin(input) + start,
+      std::begin(input) + i,
+      buffer
+    );
+
+    const auto end = buffer + (i - start);
+    const auto conversion = std::from_chars(buffer, end, real);
+
+    if (
+      conversion.ec != std::errc() ||
+      conversion.ptr != end ||
+      !std::isfinite(real) ||
+      (real != 0.0 && std::fabs(real) < DBL_MIN)
+    )
+    {
+      return errc::out_of_range;
+    }
+    if (unit)
+    {
+      result = number(real, *unit);
+    } else {
+      result = real;
+    }
+
+    return errc::ok;
+  }
+}
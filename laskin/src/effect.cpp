@@ -0,0 +1,1197 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "laskin/ast.hpp"
+#include "laskin/builtins.hpp"
+#include "laskin/chrono.hpp"
+#include "laskin/context.hpp"
+#include "laskin/effect.hpp"
+#include "laskin/error.hpp"
+
+namespace laskin
+{
+  /** Maximum number of AST nodes interpreted during single analysis. */
+  static const std::size_t max_steps = 100000;
+  /** Maximum depth of nested quote calls followed by the analysis. */
+  static const std::size_t max_calls = 64;
+  /** Maximum number of iterations used to find stable state of an loop. */
+  static const int max_iterations = 4;
+
+  /**
+   * Result of applying an arithmetic operator to values of given types.
+   */
+  struct arithmetic_rule
+  {
+    std::u32string_view word;
+    enum value::type a;
+    enum value::type b;
+    enum value::type result;
+  };
+
+  static const arithmetic_rule arithmetic_rules[] =
+  {
+    { U"+", value::type::number, value::type::number, value::type::number },
+    { U"+", value::type::vector, value::type::vector, value::type::vector },
+    { U"+", value::type::record, value::type::record, value::type::record },
+    { U"+", value::type::string, value::type::string, value::type::string },
+    { U"+", value::type::month, value::type::number, value::type::month },
+    { U"+", value::type::weekday, value::type::number, value::type::weekday },
+    { U"+", value::type::date, value::type::number, value::type::date },
+    { U"+", value::type::time, value::type::number, value::type::time },
+    { U"+", value::type::vector, value::type::number, value::type::vector },
+
+    { U"-", value::type::number, value::type::number, value::type::number },
+    { U"-", value::type::vector, value::type::vector, value::type::vector },
+    { U"-", value::type::record, value::type::record, value::type::record },
+    { U"-", value::type::date, value::type::date, value::type::number },
+    { U"-", value::type::time, value::type::time, value::type::number },
+    { U"-", value::type::month, value::type::number, value::type::month },
+    { U"-", value::type::weekday, value::type::number, value::type::weekday },
+    { U"-", value::type::date, value::type::number, value::type::date },
+    { U"-", value::type::time, value::type::number, value::type::time },
+    { U"-", value::type::vector, value::type::number, value::type::vector },
+
+    { U"*", value::type::number, value::type::number, value::type::number },
+    { U"*", value::type::vector, value::type::vector, value::type::vector },
+    { U"*", value::type::vector, value::type::number, value::type::vector },
+
+    { U"/", value::type::number, value::type::number, value::type::number },
+    { U"/", value::type::vector, value::type::vector, value::type::vector },
+    { U"/", value::type::vector, value::type::number, value::type::vector },
+
+    { U"%", value::type::number, value::type::number, value::type::number },
+    { U"%", value::type::vector, value::type::vector, value::type::vector },
+    { U"%", value::type::vector, value::type::number, value::type::vector },
+  };
+
+  /**
+   * Builtin word that calls an quote once for each element of an vector or
+   * property of an record, with given number of values pushed onto the
+   * stack for each call.
+   */
+  struct iteration_word
+  {
+    std::u32string_view word;
+    /** Values pushed onto the stack before each call. */
+    std::size_t arguments;
+    /** Values the quote is expected to leave onto the stack. */
+    std::size_t results;
+    /** Whether the topmost result of the quote must be boolean. */
+    bool test;
+  };
+
+  static const iteration_word iteration_words[] =
+  {
+    { U"vector:for-each", 1, 0, false },
+    { U"vector:map", 1, 1, false },
+    { U"vector:filter", 1, 1, true },
+    { U"vector:reduce", 2, 1, false },
+    { U"record:for-each", 2, 0, false },
+    { U"record:map", 2, 2, false },
+    { U"record:filter", 2, 1, true },
+  };
+
+  /**
+   * Value on the stack during the analysis.
+   */
+  struct effect_slot
+  {
+    /** Type of the value, if known. */
+    std::optional<enum value::type> type;
+    /** The value itself, if it's an quote known during the analysis. */
+    std::optional<quote> literal;
+    /** Index of the input this value is an unmodified copy of, if any. */
+    std::optional<std::size_t> input;
+  };
+
+  /**
+   * State of the stack and the dictionary during the analysis.
+   */
+  struct effect_state
+  {
+    /** Values pushed onto the stack. */
+    std::vector<effect_slot> stack;
+    /**
+     * Types of values taken from the stack below the pushed ones, in the
+     * order they were taken.
+     */
+    effect::type_container inputs;
+    /** Words defined with `->` during the analysis. */
+    std::unordered_map<std::u32string, effect_slot> locals;
+    /** Local variables bound during the analysis, by scope and slot. */
+    std::map<std::pair<const scope*, std::size_t>, effect_slot> variables;
+    /**
+     * Whether the contents of the stack are known. Once this is cleared, the
+     * analysis continues only to find errors.
+     */
+    bool determinate = true;
+    /** Whether the stack is known to contain nothing below pushed values. */
+    bool closed = false;
+    /** Whether the dictionary may have been modified by the analyzed code. */
+    bool dictionary_changed = false;
+    /**
+     * Whether the analyzed code is not being called but only checked, in
+     * which case words that are not defined yet are not errors.
+     */
+    bool speculative = false;
+  };
+
+  static std::optional<enum value::type>
+  parse_type(std::u32string_view name)
+  {
+    for (std::size_t i = 0; i < value::type_count; ++i)
+    {
+      const auto type = static_cast<enum value::type>(i);
+
+      if (!value::type_description(type).compare(name))
+      {
+        return type;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  static bool
+  is_type_variable(std::u32string_view token)
+  {
+    return token.length() == 1 && token[0] >= 'a' && token[0] <= 'z';
+  }
+
+  static std::vector<std::u32string_view>
+  split_signature(std::u32string_view signature)
+  {
+    std::vector<std::u32string_view> tokens;
+    std::u32string_view::size_type start = 0;
+
+    while (start < signature.length())
+    {
+      const auto end = signature.find(' ', start);
+
+      if (end == std::u32string_view::npos)
+      {
+        tokens.push_back(signature.substr(start));
+        break;
+      }
+      if (end > start)
+      {
+        tokens.push_back(signature.substr(start, end - start));
+      }
+      start = end + 1;
+    }
+
+    return tokens;
+  }
+
+  static std::optional<std::u32string_view>
+  builtin_name(quote::native word)
+  {
+    static const auto names = ([]()
+    {
+      std::unordered_map<quote::native, std::u32string_view> result;
+
+      for (const auto& definition : builtins::all())
+      {
+        result[definition.second] = definition.first;
+      }
+
+      return result;
+    })();
+    const auto entry = names.find(word);
+
+    if (entry != std::end(names))
+    {
+      return entry->second;
+    }
+
+    return std::nullopt;
+  }
+
+  static const iteration_word*
+  find_iteration_word(std::u32string_view name)
+  {
+    for (const auto& word : iteration_words)
+    {
+      if (word.word == name)
+      {
+        return &word;
+      }
+    }
+
+    return nullptr;
+  }
+
+  static effect_slot
+  merge_slots(const effect_slot& a, const effect_slot& b)
+  {
+    effect_slot result;
+
+    if (a.type == b.type)
+    {
+      result.type = a.type;
+    }
+    if (a.literal && b.literal && *a.literal == *b.literal)
+    {
+      result.literal = a.literal;
+    }
+    if (a.input == b.input)
+    {
+      result.input = a.input;
+    }
+
+    return result;
+  }
+
+  static bool
+  same_slots(const effect_slot& a, const effect_slot& b)
+  {
+    return a.type == b.type
+      && a.input == b.input
+      && a.literal.has_value() == b.literal.has_value()
+      && (!a.literal || *a.literal == *b.literal);
+  }
+
+  /**
+   * Makes the state refer to given number of inputs, by taking the missing
+   * ones from the stack and pushing them back.
+   */
+  static void
+  extend_inputs(effect_state& state, std::size_t count)
+  {
+    while (state.inputs.size() < count)
+    {
+      effect_slot slot;
+
+      slot.input = state.inputs.size();
+      state.inputs.push_back(std::nullopt);
+      state.stack.insert(std::begin(state.stack), slot);
+    }
+  }
+
+  /**
+   * Combines states of two alternative code paths into one that holds
+   * regardless of which one was taken.
+   */
+  static effect_state
+  merge_states(effect_state a, effect_state b)
+  {
+    effect_state result;
+
+    result.closed = a.closed;
+    result.speculative = a.speculative;
+    result.dictionary_changed = a.dictionary_changed || b.dictionary_changed;
+    for (const auto& local : a.locals)
+    {
+      const auto other = b.locals.find(local.first);
+
+      result.locals[local.first] = other != std::end(b.locals)
+        ? merge_slots(local.second, other->second)
+        : effect_slot();
+    }
+    for (const auto& local : b.locals)
+    {
+      if (result.locals.find(local.first) == std::end(result.locals))
+      {
+        result.locals[local.first] = effect_slot();
+      }
+    }
+    for (const auto& variable : a.variables)
+    {
+      const auto other = b.variables.find(variable.first);
+
+      result.variables[variable.first] = other != std::end(b.variables)
+        ? merge_slots(variable.second, other->second)
+        : effect_slot();
+    }
+    for (const auto& variable : b.variables)
+    {
+      if (result.variables.find(variable.first) == std::end(result.variables))
+      {
+        result.variables[variable.first] = effect_slot();
+      }
+    }
+    if (a.determinate && b.determinate)
+    {
+      const auto count = std::max(a.inputs.size(), b.inputs.size());
+
+      extend_inputs(a, count);
+      extend_inputs(b, count);
+      if (a.stack.size() == b.stack.size())
+      {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          result.inputs.push_back(
+            a.inputs[i] == b.inputs[i] ? a.inputs[i] : std::nullopt
+          );
+        }
+        for (std::size_t i = 0; i < a.stack.size(); ++i)
+        {
+          result.stack.push_back(merge_slots(a.stack[i], b.stack[i]));
+        }
+
+        return result;
+      }
+    }
+    result.determinate = false;
+
+    return result;
+  }
+
+  static bool
+  same_states(const effect_state& a, const effect_state& b)
+  {
+    if (a.determinate != b.determinate
+        || a.inputs != b.inputs
+        || a.stack.size() != b.stack.size())
+    {
+      return false;
+    }
+    for (std::size_t i = 0; i < a.stack.size(); ++i)
+    {
+      if (!same_slots(a.stack[i], b.stack[i]))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Interprets AST nodes with types instead of values.
+   */
+  class effect_analysis
+  {
+  public:
+    explicit effect_analysis(const class context& context, bool check)
+      : m_context(context)
+      , m_check(check)
+      , m_steps(0) {}
+
+    void run(const quote::node_container& nodes, effect_state& state)
+    {
+      const auto previous_position = m_position;
+
+      for (const auto& node : nodes)
+      {
+        if (node->position)
+        {
+          m_position = node->position;
+        }
+        run(node, state);
+      }
+      m_position = previous_position;
+    }
+
+    void call(const quote& quote, effect_state& state)
+    {
+      if (const auto word = quote.target())
+      {
+        if (const auto name = builtin_name(word))
+        {
+          builtin(*name, state);
+        } else {
+          forget(state);
+        }
+        return;
+      }
+      else if (quote.is_native())
+      {
+        forget(state);
+        return;
+      }
+
+      const auto nodes = quote.nodes();
+
+      if (nodes.empty())
+      {
+        return;
+      }
+      else if (m_steps > max_steps
+          || m_active.size() >= max_calls
+          || m_active.find(nodes[0].get()) != std::end(m_active))
+      {
+        forget(state);
+        return;
+      }
+      m_active.insert(nodes[0].get());
+      run(nodes, state);
+      m_active.erase(nodes[0].get());
+    }
+
+  private:
+    void run(const std::shared_ptr<node>& node, effect_state& state)
+    {
+      ++m_steps;
+      switch (node->type())
+      {
+        case node::type::binding:
+          {
+            const auto binding = std::static_pointer_cast<node::binding>(
+              node
+            );
+
+            for (auto i = binding->slots.size(); i > 0; --i)
+            {
+              state.variables[
+                { binding->scope.get(), binding->slots[i - 1] }
+              ] = pop(state);
+            }
+          }
+          break;
+
+        case node::type::closure:
+          {
+            effect_slot slot;
+
+            slot.type = value::type::quote;
+            slot.literal = std::static_pointer_cast<node::closure>(
+              node
+            )->value.as_quote();
+            state.stack.push_back(slot);
+          }
+          break;
+
+        case node::type::compiled:
+          run(std::static_pointer_cast<node::compiled>(node)->nodes, state);
+          break;
+
+        case node::type::definition:
+          {
+            const auto slot = pop(state);
+
+            if (slot.literal && m_check)
+            {
+              speculate(*slot.literal, state);
+            }
+            state.locals[
+              std::static_pointer_cast<node::definition>(node)->id
+            ] = slot;
+          }
+          break;
+
+        case node::type::literal:
+          {
+            const auto& constant = std::static_pointer_cast<node::literal>(
+              node
+            )->value;
+            effect_slot slot;
+
+            slot.type = constant.type();
+            if (constant.is(value::type::quote))
+            {
+              slot.literal = constant.as_quote();
+            }
+            state.stack.push_back(slot);
+          }
+          break;
+
+        case node::type::local:
+          {
+            const auto local = std::static_pointer_cast<node::local>(node);
+            const auto variable = state.variables.find(
+              { local->scope.get(), local->slot }
+            );
+
+            if (variable != std::end(state.variables))
+            {
+              invoke(variable->second, state);
+            } else {
+              forget(state);
+            }
+          }
+          break;
+
+        case node::type::record_literal:
+          for (const auto& property :
+               std::static_pointer_cast<node::record_literal>(
+                 node
+               )->properties)
+          {
+            evaluate(property.second, state);
+          }
+          push(state, value::type::record);
+          break;
+
+        case node::type::symbol:
+          symbol(std::static_pointer_cast<node::symbol>(node)->id, state);
+          break;
+
+        case node::type::vector_literal:
+          for (const auto& element :
+               std::static_pointer_cast<node::vector_literal>(
+                 node
+               )->elements)
+          {
+            evaluate(element, state);
+          }
+          push(state, value::type::vector);
+          break;
+      }
+    }
+
+    /**
+     * Analyzes an element of vector or record literal, which is evaluated as
+     * an expression instead of being executed.
+     */
+    void evaluate(const std::shared_ptr<node>& node, effect_state& state)
+    {
+      if (node->type() == node::type::symbol)
+      {
+        if (!std::static_pointer_cast<node::symbol>(node)->id.compare(
+          U"drop"
+        ))
+        {
+          pop(state);
+        }
+      }
+      else if (node->type() == node::type::vector_literal)
+      {
+        for (const auto& element :
+             std::static_pointer_cast<node::vector_literal>(node)->elements)
+        {
+          evaluate(element, state);
+        }
+      }
+      else if (node->type() == node::type::record_literal)
+      {
+        for (const auto& property :
+             std::static_pointer_cast<node::record_literal>(node)->properties)
+        {
+          evaluate(property.second, state);
+        }
+      }
+    }
+
+    /**
+     * Checks the contents of an quote being defined as an word for errors,
+     * without assuming anything about the stack it will be called with.
+     */
+    void speculate(const quote& quote, const effect_state& state)
+    {
+      effect_state body;
+
+      body.locals = state.locals;
+      body.variables = state.variables;
+      body.dictionary_changed = state.dictionary_changed;
+      body.speculative = true;
+      call(quote, body);
+    }
+
+    void symbol(const std::u32string& id, effect_state& state)
+    {
+      const auto types = method_types(id, state);
+
+      if (!types.empty()
+          && (!state.stack.empty() || !state.closed || !state.determinate))
+      {
+        const auto top = state.stack.empty()
+          ? std::nullopt
+          : state.stack.back().type;
+
+        if (top)
+        {
+          if (std::find(std::begin(types), std::end(types), *top)
+              != std::end(types))
+          {
+            invoke(*word(value::type_description(*top) + U":" + id, state),
+                   state);
+            return;
+          }
+        }
+        else if (types.size() == 1 && !word(id, state))
+        {
+          // Unless the topmost value is of the only type that has such an
+          // word, the symbol would not be recognized at all.
+          state.stack.push_back(pop(state, types[0]));
+          invoke(
+            *word(value::type_description(types[0]) + U":" + id, state),
+            state
+          );
+          return;
+        } else {
+          forget(state);
+          return;
+        }
+      }
+
+      if (const auto slot = word(id, state))
+      {
+        invoke(*slot, state);
+      }
+      else if (number::is_valid(id))
+      {
+        push(state, value::type::number);
+      }
+      else if (is_date(id))
+      {
+        push(state, value::type::date);
+      }
+      else if (is_time(id))
+      {
+        push(state, value::type::time);
+      }
+      else if (state.speculative
+          || state.dictionary_changed
+          || m_context.default_callback)
+      {
+        forget(state);
+      } else {
+        throw error(
+          error::type::name,
+          U"Unrecognized symbol: `" + id + U"'",
+          m_position
+        );
+      }
+    }
+
+    /**
+     * Returns the value types that have an typed word with given name.
+     */
+    std::vector<enum value::type> method_types(
+      const std::u32string& id,
+      const effect_state& state
+    ) const
+    {
+      std::vector<enum value::type> result;
+
+      for (std::size_t i = 0; i < value::type_count; ++i)
+      {
+        const auto type = static_cast<enum value::type>(i);
+        const auto name = value::type_description(type) + U":" + id;
+
+        if (state.locals.find(name) != std::end(state.locals)
+            || m_context.dictionary().find(name) != std::end(
+              m_context.dictionary()
+            ))
+        {
+          result.push_back(type);
+        }
+      }
+
+      return result;
+    }
+
+    /**
+     * Looks up an word from the words defined during the analysis and from
+     * the dictionary of the context.
+     */
+    std::optional<effect_slot> word(
+      const std::u32string& id,
+      const effect_state& state
+    ) const
+    {
+      const auto local = state.locals.find(id);
+
+      if (local != std::end(state.locals))
+      {
+        return local->second;
+      }
+
+      const auto entry = m_context.dictionary().find(id);
+
+      if (entry != std::end(m_context.dictionary()))
+      {
+        effect_slot slot;
+
+        slot.type = entry->second.type();
+        if (entry->second.is(value::type::quote))
+        {
+          slot.literal = entry->second.as_quote();
+        }
+
+        return slot;
+      }
+
+      return std::nullopt;
+    }
+
+    void invoke(const effect_slot& slot, effect_state& state)
+    {
+      if (!slot.type)
+      {
+        forget(state);
+      }
+      else if (*slot.type != value::type::quote)
+      {
+        state.stack.push_back(slot);
+      }
+      else if (slot.literal)
+      {
+        call(*slot.literal, state);
+      } else {
+        forget(state);
+      }
+    }
+
+    void builtin(std::u32string_view name, effect_state& state)
+    {
+      const auto signature = builtins::signature(name);
+
+      if (!signature)
+      {
+        forget(state);
+      }
+      else if (name == U"quote:dip")
+      {
+        const auto quote = pop(state, value::type::quote);
+        const auto value = pop(state);
+
+        if (quote.literal)
+        {
+          call(*quote.literal, state);
+        } else {
+          forget(state);
+        }
+        state.stack.push_back(value);
+      }
+      else if (name == U"+"
+          || name == U"-"
+          || name == U"*"
+          || name == U"/"
+          || name == U"%")
+      {
+        arithmetic(name, state);
+      } else {
+        const auto arguments = apply(*signature, state);
+
+        if (name == U"quote:call")
+        {
+          if (arguments[0].literal)
+          {
+            call(*arguments[0].literal, state);
+          } else {
+            forget(state);
+          }
+        }
+        else if (name == U"if")
+        {
+          branch(arguments[1].literal, quote(quote::node_container()), state);
+        }
+        else if (name == U"if-else")
+        {
+          branch(arguments[1].literal, arguments[2].literal, state);
+        }
+        else if (name == U"while")
+        {
+          loop(arguments[0].literal, arguments[1].literal, true, state);
+        }
+        else if (name == U"number:times")
+        {
+          loop(std::nullopt, arguments[0].literal, false, state);
+        }
+        else if (const auto word = find_iteration_word(name))
+        {
+          iterate(*word, arguments[0].literal, state);
+        }
+        else if (name == U"define"
+            || name == U"delete"
+            || name == U"include"
+            || name == U"try"
+            || name == U"try-else"
+            || name == U"exit"
+            || name == U"quit")
+        {
+          state.dictionary_changed = true;
+          forget(state);
+        }
+      }
+    }
+
+    /**
+     * Takes values described by the signature of an builtin word from the
+     * stack and pushes the values it leaves there. Returns the values taken
+     * from the stack.
+     */
+    std::vector<effect_slot> apply(
+      std::u32string_view signature,
+      effect_state& state
+    )
+    {
+      const auto tokens = split_signature(signature);
+      const auto separator = std::find(
+        std::begin(tokens),
+        std::end(tokens),
+        U"--"
+      );
+      const auto inputs = static_cast<std::size_t>(
+        std::distance(std::begin(tokens), separator) - 1
+      );
+      std::vector<effect_slot> arguments(inputs);
+      std::unordered_map<std::u32string_view, effect_slot> variables;
+
+      for (std::size_t i = inputs; i > 0; --i)
+      {
+        const auto& token = tokens[i];
+
+        if (token == U"any...")
+        {
+          forget(state);
+          return arguments;
+        }
+        arguments[i - 1] = pop(state, parse_type(token));
+        if (is_type_variable(token))
+        {
+          variables[token] = arguments[i - 1];
+        }
+      }
+      for (auto i = separator + 1; i + 1 < std::end(tokens); ++i)
+      {
+        const auto variable = variables.find(*i);
+
+        if (*i == U"any...")
+        {
+          forget(state);
+        }
+        else if (variable != std::end(variables))
+        {
+          state.stack.push_back(variable->second);
+        } else {
+          effect_slot slot;
+
+          slot.type = parse_type(*i);
+          state.stack.push_back(slot);
+        }
+      }
+
+      return arguments;
+    }
+
+    void arithmetic(std::u32string_view name, effect_state& state)
+    {
+      const auto b = pop(state);
+      const auto a = pop(state);
+
+      if (!a.type || !b.type)
+      {
+        state.stack.push_back(effect_slot());
+        return;
+      }
+      for (const auto& rule : arithmetic_rules)
+      {
+        if (rule.word == name && rule.a == *a.type && rule.b == *b.type)
+        {
+          push(state, rule.result);
+          return;
+        }
+      }
+
+      throw error(
+        error::type::type,
+        U"Cannot apply `" +
+        std::u32string(name) +
+        U"' to " +
+        value::type_description(*a.type) +
+        U" and " +
+        value::type_description(*b.type) +
+        U".",
+        m_position
+      );
+    }
+
+    /**
+     * Analyzes call to either one of given quotes. Missing quote means that
+     * the quote is only known at runtime.
+     */
+    void branch(
+      const std::optional<quote>& a,
+      const std::optional<quote>& b,
+      effect_state& state
+    )
+    {
+      effect_state then_state = state;
+      effect_state else_state = state;
+
+      if (!a || !b)
+      {
+        forget(state);
+        return;
+      }
+      call(*a, then_state);
+      call(*b, else_state);
+      state = merge_states(then_state, else_state);
+    }
+
+    /**
+     * Analyzes an loop that executes the body repeatedly, either for as long
+     * as the condition leaves true onto the stack or given number of times
+     * when the loop has no condition. The loop can only be analyzed when the
+     * stack has the same shape before and after each iteration.
+     */
+    void loop(
+      const std::optional<quote>& condition,
+      const std::optional<quote>& body,
+      bool conditional,
+      effect_state& state
+    )
+    {
+      if ((conditional && !condition) || !body)
+      {
+        forget(state);
+        return;
+      }
+      for (int i = 0; i < max_iterations; ++i)
+      {
+        effect_state next = state;
+
+        if (conditional)
+        {
+          call(*condition, next);
+          pop(next, value::type::boolean);
+        }
+        call(*body, next);
+        next = merge_states(state, next);
+        if (same_states(state, next))
+        {
+          if (conditional)
+          {
+            call(*condition, state);
+            pop(state, value::type::boolean);
+          }
+          return;
+        }
+        state = next;
+      }
+      forget(state);
+    }
+
+    /**
+     * Analyzes an quote called once for each element of an vector or
+     * property of an record. The quote must consume the values given to it
+     * and leave the expected number of values onto the stack.
+     */
+    void iterate(
+      const iteration_word& word,
+      const std::optional<quote>& quote,
+      effect_state& state
+    )
+    {
+      effect_state body;
+
+      if (!quote)
+      {
+        forget(state);
+        return;
+      }
+      body.locals = state.locals;
+      body.variables = state.variables;
+      body.dictionary_changed = state.dictionary_changed;
+      body.speculative = state.speculative;
+      body.stack.resize(word.arguments);
+      call(*quote, body);
+      if (!body.determinate
+          || !body.inputs.empty()
+          || body.stack.size() != word.results)
+      {
+        forget(state);
+        return;
+      }
+      if (word.test)
+      {
+        pop(body, value::type::boolean);
+      }
+      if (body.dictionary_changed)
+      {
+        state.dictionary_changed = true;
+      }
+    }
+
+    effect_slot pop(
+      effect_state& state,
+      const std::optional<enum value::type>& type = std::nullopt
+    )
+    {
+      effect_slot slot;
+
+      if (!state.stack.empty())
+      {
+        slot = state.stack.back();
+        state.stack.pop_back();
+        if (type)
+        {
+          refine(slot, *type, state);
+        }
+      }
+      else if (state.determinate && state.closed)
+      {
+        throw error(error::type::range, U"Stack underflow.", m_position);
+      }
+      else if (state.determinate)
+      {
+        slot.type = type;
+        slot.input = state.inputs.size();
+        state.inputs.push_back(type);
+      } else {
+        slot.type = type;
+      }
+
+      return slot;
+    }
+
+    void push(effect_state& state, enum value::type type)
+    {
+      effect_slot slot;
+
+      slot.type = type;
+      state.stack.push_back(slot);
+    }
+
+    /**
+     * Requires given value to be of given type. If the type of the value is
+     * not known yet and the value is an input, all copies of the input are
+     * known to be of given type from now on.
+     */
+    void refine(
+      effect_slot& slot,
+      enum value::type type,
+      effect_state& state
+    ) const
+    {
+      if (slot.type)
+      {
+        if (*slot.type != type)
+        {
+          throw error(
+            error::type::type,
+            U"Unexpected " +
+            value::type_description(*slot.type) +
+            U"; Was excepting " +
+            value::type_description(type) +
+            U".",
+            m_position
+          );
+        }
+        return;
+      }
+      slot.type = type;
+      if (!slot.input)
+      {
+        return;
+      }
+      if (!state.inputs[*slot.input])
+      {
+        state.inputs[*slot.input] = type;
+      }
+      for (auto& other : state.stack)
+      {
+        if (other.input == slot.input && !other.type)
+        {
+          other.type = type;
+        }
+      }
+      for (auto& local : state.locals)
+      {
+        if (local.second.input == slot.input && !local.second.type)
+        {
+          local.second.type = type;
+        }
+      }
+      for (auto& variable : state.variables)
+      {
+        if (variable.second.input == slot.input && !variable.second.type)
+        {
+          variable.second.type = type;
+        }
+      }
+    }
+
+    /**
+     * Marks the contents of the stack unknown.
+     */
+    void forget(effect_state& state) const
+    {
+      state.stack.clear();
+      state.determinate = false;
+    }
+
+  private:
+    const class context& m_context;
+    /** Whether the program is being checked for errors. */
+    const bool m_check;
+    /** Number of AST nodes interpreted so far. */
+    std::size_t m_steps;
+    /** Quotes being called, identified by their first AST node. */
+    std::unordered_set<const node*> m_active;
+    /** Position of the AST node being interpreted. */
+    std::optional<struct position> m_position;
+  };
+
+  std::optional<effect>
+  effect::infer(const quote& quote, const class context& context)
+  {
+    effect_analysis analysis(context, false);
+    effect_state state;
+    effect result;
+
+    analysis.call(quote, state);
+    if (!state.determinate)
+    {
+      return std::nullopt;
+    }
+    result.inputs.assign(std::rbegin(state.inputs), std::rend(state.inputs));
+    for (const auto& slot : state.stack)
+    {
+      result.outputs.push_back(slot.type);
+    }
+
+    return result;
+  }
+
+  void
+  effect::check(const quote& program, const class context& context)
+  {
+    effect_analysis analysis(context, true);
+    effect_state state;
+
+    state.closed = true;
+    analysis.call(program, state);
+  }
+
+  std::u32string
+  effect::to_source() const
+  {
+    std::u32string result(1, '(');
+
+    for (const auto& type : inputs)
+    {
+      result += U' ';
+      result += type ? value::type_description(*type) : U"any";
+    }
+    result += U" --";
+    for (const auto& type : outputs)
+    {
+      result += U' ';
+      result += type ? value::type_description(*type) : U"any";
+    }
+    result += U" )";
+
+    return result;
+  }
+}
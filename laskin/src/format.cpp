@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <charconv>
+#include <cmath>
+#include <exception>
+
+#include "laskin/format.hpp"
+
+namespace laskin::format
+{
+  char*
+  integer(char* buffer, long value)
+  {
+    return std::to_chars(buffer, buffer + buffer_size, value).ptr;
+  }
+
+  char*
+  real(char* buffer, double value)
+  {
+    const auto magnitude = std::fabs(value);
+
+    if (!std::isfinite(value))
+    {
+      return nullptr;
+    }
+    // Left on it's own, `std::to_chars()` picks whichever notation is
+    // shorter, which would print one million as `1e+06`. Exponent notation
+    // is used only for numbers that would otherwise need lots of zeros.
+    else if (magnitude == 0 || (magnitude >= 1e-6 && magnitude < 1e21))
+    {
+      return std::to_chars(
+        buffer,
+        buffer + buffer_size,
+        value,
+        std::chars_format::fixed
+      ).ptr;
+    }
+
+    return std::to_chars(
+      buffer,
+      buffer + buffer_size,
+      value,
+      std::chars_format::scientific
+    ).ptr;
+  }
+
+  char*
+  number(char* buffer, const value& value)
+  {
+    double result;
+
+    if (value.is_integer())
+    {
+      return integer(buffer, value.as_integer());
+    }
+    else if (value.is_real())
+    {
+      return real(buffer, value.as_real());
+    }
+    else if (value.is_big_integer())
+    {
+      // Big integers can have more digits than what fits into the buffer.
+      return nullptr;
+    }
+
+    const auto& number = value.as_number();
+
+    if (number.measurement_unit())
+    {
+      return nullptr;
+    }
+    try
+    {
+      result = double(number);
+    }
+    catch (const std::exception&)
+    {
+      return nullptr;
+    }
+    // Numbers with more precision than double can hold must be formatted
+    // with all of their digits.
+    if (!(laskin::number(result) == number))
+    {
+      return nullptr;
+    }
+
+    return real(buffer, result);
+  }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <limits>
+
+#include <mpfr.h>
+
+#include "laskin/error.hpp"
+#include "laskin/numeric.hpp"
+
+namespace laskin
+{
+  /**
+   * Whether the precision of arbitrary precision numbers has ever been set
+   * to something else than the precision of double in the current thread.
+   */
+  static thread_local bool precision_changed = false;
+
+  numeric::numeric(enum mode mode)
+    : m_mode(mode) {}
+
+  long
+  numeric::precision()
+  {
+    return static_cast<long>(mpfr_get_default_prec());
+  }
+
+  void
+  numeric::set_precision(long bits)
+  {
+    if (bits < MPFR_PREC_MIN || bits > MPFR_PREC_MAX)
+    {
+      throw error(error::type::range, U"Precision out of range.");
+    }
+    if (bits != std::numeric_limits<double>::digits)
+    {
+      precision_changed = true;
+    }
+    mpfr_set_default_prec(static_cast<mpfr_prec_t>(bits));
+  }
+
+  bool
+  numeric::is_double_precision()
+  {
+    return !precision_changed
+      && precision() == std::numeric_limits<double>::digits;
+  }
+
+  value
+  numeric::to_real(const value& value)
+  {
+    if (value.is_integer() || value.is_big_integer() || value.is_real())
+    {
+      return value;
+    }
+
+    const auto& number = value.as_number();
+
+    if (number.measurement_unit())
+    {
+      return value;
+    }
+
+    return value::real(double(number));
+  }
+}
@@ -23,7 +23,10 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include "laskin/big_integer.hpp"
 #include "laskin/error.hpp"
+#include "laskin/integer.hpp"
+#include "laskin/units.hpp"
 #include "laskin/value.hpp"
 
 namespace laskin
@@ -51,9 +54,9 @@ namespace laskin
   {
     long delta;
 
-    if (const auto& unit = b.as_number().measurement_unit())
+    if (const auto unit = b.unit_id())
     {
-      if (!unit->symbol.compare("d"))
+      if (unit == units::day)
       {
         delta = long(b);
       } else {
@@ -74,9 +77,9 @@ namespace laskin
   {
     long delta;
 
-    if (const auto& unit = b.as_number().measurement_unit())
+    if (const auto unit = b.unit_id())
     {
-      if (!unit->symbol.compare("d"))
+      if (unit == units::day)
       {
         delta = long(b);
       } else {
@@ -95,30 +98,14 @@ namespace laskin
   static value
   add_time(const time& a, const value& b)
   {
-    using peelo::chrono::duration;
-
     long delta;
 
-    if (const auto& unit = b.as_number().measurement_unit())
+    if (const auto unit = b.unit_id())
     {
-      duration::value_type multiplier;
+      const auto multiplier = units::seconds(unit);
 
-      if (!unit->symbol.compare("s"))
-      {
-        multiplier = 1;
-      }
-      else if (!unit->symbol.compare("min"))
-      {
-        multiplier = duration::minutes_per_hour;
-      }
-      else if (!unit->symbol.compare("h"))
-      {
-        multiplier = duration::seconds_per_hour;
-      }
-      else if (!unit->symbol.compare("d"))
+      if (!multiplier)
       {
-        multiplier = duration::seconds_per_day;
-      } else {
         throw error(
           error::type::type,
           U"Cannot add number to time."
@@ -142,7 +129,30 @@ namespace laskin
         switch (m_type)
         {
           case type::number:
-            return *m_value_number + *that.m_value_number;
+            if (is_real_operation(that))
+            {
+              const auto a = static_cast<double>(*this);
+              const auto b = static_cast<double>(that);
+
+              return real(a + b);
+            }
+            else if (m_integer && that.m_integer)
+            {
+              const auto a = m_value_integer;
+              const auto b = that.m_value_integer;
+              long result;
+
+              if (integer::add(a, b, result))
+              {
+                return result;
+              }
+            }
+            if (is_integer_operation(that))
+            {
+              return to_big_integer() + that.to_big_integer();
+            }
+
+            return as_number() + that.as_number();
 
           case type::vector:
             return *m_value_vector + *that.m_value_vector;
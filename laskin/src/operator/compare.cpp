@@ -23,6 +23,7 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include "laskin/big_integer.hpp"
 #include "laskin/error.hpp"
 #include "laskin/value.hpp"
 
@@ -70,7 +71,25 @@ namespace laskin
         switch (m_type)
         {
           case type::number:
-            return m_value_number->compare(*that.m_value_number);
+            if (is_real_operation(that))
+            {
+              const auto a = static_cast<double>(*this);
+              const auto b = static_cast<double>(that);
+
+              return a > b ? 1 : a < b ? -1 : 0;
+            }
+            else if (m_integer && that.m_integer)
+            {
+              return m_value_integer > that.m_value_integer
+                ? 1
+                : m_value_integer < that.m_value_integer ? -1 : 0;
+            }
+            else if (is_integer_operation(that))
+            {
+              return to_big_integer().compare(that.to_big_integer());
+            }
+
+            return as_number().compare(that.as_number());
 
           case type::string:
             return m_value_string->compare(*that.m_value_string);
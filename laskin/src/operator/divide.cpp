@@ -38,7 +38,15 @@ namespace laskin
         switch (m_type)
         {
           case type::number:
-            return *m_value_number / *that.m_value_number;
+            if (is_real_operation(that))
+            {
+              const auto a = static_cast<double>(*this);
+              const auto b = static_cast<double>(that);
+
+              return real(a / b);
+            }
+
+            return as_number() / that.as_number();
 
           case type::vector:
             return *m_value_vector / *that.m_value_vector;
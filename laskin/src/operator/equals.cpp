@@ -23,6 +23,7 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include "laskin/big_integer.hpp"
 #include "laskin/quote.hpp"
 #include "laskin/value.hpp"
 
@@ -39,7 +40,20 @@ namespace laskin
           return m_value_boolean == that.m_value_boolean;
 
         case type::number:
-          return *m_value_number == *that.m_value_number;
+          if (is_real_operation(that))
+          {
+            return static_cast<double>(*this) == static_cast<double>(that);
+          }
+          else if (m_integer && that.m_integer)
+          {
+            return m_value_integer == that.m_value_integer;
+          }
+          else if (is_integer_operation(that))
+          {
+            return !to_big_integer().compare(that.to_big_integer());
+          }
+
+          return as_number() == that.as_number();
 
         case type::vector:
           return *m_value_vector == *that.m_value_vector;
@@ -23,7 +23,11 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <cmath>
+
+#include "laskin/big_integer.hpp"
 #include "laskin/error.hpp"
+#include "laskin/integer.hpp"
 #include "laskin/value.hpp"
 
 namespace laskin
@@ -38,7 +42,33 @@ namespace laskin
         switch (m_type)
         {
           case type::number:
-            return *m_value_number % *that.m_value_number;
+            if (is_real_operation(that))
+            {
+              const auto a = static_cast<double>(*this);
+              const auto b = static_cast<double>(that);
+
+              return real(std::fmod(a, b));
+            }
+            else if (m_integer && that.m_integer)
+            {
+              const auto a = m_value_integer;
+              const auto b = that.m_value_integer;
+              long result;
+
+              if (integer::modulo(a, b, result))
+              {
+                return result;
+              }
+            }
+            else if (
+              is_integer_operation(that) &&
+              !that.to_big_integer().is_zero()
+            )
+            {
+              return to_big_integer() % that.to_big_integer();
+            }
+
+            return as_number() % that.as_number();
 
           case type::vector:
             return *m_value_vector % *that.m_value_vector;
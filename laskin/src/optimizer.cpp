@@ -0,0 +1,1949 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
+#include "laskin/builtins.hpp"
+#include "laskin/chrono.hpp"
+#include "laskin/context.hpp"
+#include "laskin/error.hpp"
+#include "laskin/integer.hpp"
+#include "laskin/optimizer.hpp"
+
+namespace laskin::optimizer
+{
+  /**
+   * Builtin words whose result depends only on the values they take from the
+   * stack, and which have no side effects. Applications of these words to
+   * constant values are evaluated when the quote is compiled.
+   */
+  static const std::u32string_view pure_words[] =
+  {
+    // Boolean words.
+    U"true",
+    U"false",
+    U"boolean:not",
+    U"boolean:and",
+    U"boolean:or",
+    U"boolean:xor",
+
+    // Date words.
+    U"date:year",
+    U"date:month",
+    U"date:day",
+    U"date:weekday",
+    U"date:day-of-year",
+    U"date:days-in-month",
+    U"date:days-in-year",
+    U"date:leap-year?",
+    U"date:format",
+    U"date:>number",
+    U"date:>vector",
+
+    // Month words.
+    U"january",
+    U"february",
+    U"march",
+    U"april",
+    U"may",
+    U"june",
+    U"july",
+    U"august",
+    U"september",
+    U"october",
+    U"november",
+    U"december",
+    U"month:>number",
+
+    // Numeric words.
+    U"pi",
+    U"e",
+    U"inf",
+    U"-inf",
+    U"nan",
+    U"number:has-unit?",
+    U"number:unit",
+    U"number:unit-type",
+    U"number:drop-unit",
+    U"number:inf?",
+    U"number:nan?",
+    U"number:range",
+    U"number:clamp",
+    U"number:ceil",
+    U"number:floor",
+    U"number:round",
+    U"number:exp",
+    U"number:exp2",
+    U"number:expm1",
+    U"number:log",
+    U"number:log10",
+    U"number:log2",
+    U"number:log1p",
+    U"number:pow",
+    U"number:sqrt",
+    U"number:cbrt",
+    U"number:hypot",
+    U"number:acos",
+    U"number:asin",
+    U"number:atan",
+    U"number:atan2",
+    U"number:cos",
+    U"number:sin",
+    U"number:tan",
+    U"number:deg",
+    U"number:rad",
+    U"number:sinh",
+    U"number:cosh",
+    U"number:tanh",
+    U"number:asinh",
+    U"number:acosh",
+    U"number:atanh",
+    U"number:>month",
+    U"number:>weekday",
+
+    // Record words.
+    U"record:size",
+    U"record:keys",
+    U"record:values",
+    U"record:@",
+    U"record:@=",
+    U"record:>vector",
+
+    // String words.
+    U"string:length",
+    U"string:chars",
+    U"string:runes",
+    U"string:words",
+    U"string:lines",
+    U"string:starts-with?",
+    U"string:ends-with?",
+    U"string:includes?",
+    U"string:index-of",
+    U"string:last-index-of",
+    U"string:reverse",
+    U"string:lower-case",
+    U"string:upper-case",
+    U"string:swap-case",
+    U"string:trim",
+    U"string:trim-start",
+    U"string:trim-end",
+    U"string:substring",
+    U"string:split",
+    U"string:repeat",
+    U"string:replace",
+    U"string:pad-start",
+    U"string:pad-end",
+    U"string:@",
+    U"string:>number",
+
+    // Time words.
+    U"time:hour",
+    U"time:minute",
+    U"time:second",
+    U"time:format",
+    U"time:>number",
+    U"time:>vector",
+
+    // Utility words.
+    U"=",
+    U"<>",
+    U">",
+    U"<",
+    U">=",
+    U"<=",
+    U"+",
+    U"-",
+    U"*",
+    U"/",
+    U"%",
+    U"boolean?",
+    U"date?",
+    U"month?",
+    U"number?",
+    U"vector?",
+    U"record?",
+    U"string?",
+    U"time?",
+    U"quote?",
+    U"weekday?",
+    U"dup",
+    U"drop",
+    U"nip",
+    U"over",
+    U"rot",
+    U"swap",
+    U"tuck",
+    U">string",
+    U">source",
+
+    // Vector words.
+    U"vector:length",
+    U"vector:max",
+    U"vector:min",
+    U"vector:mean",
+    U"vector:sum",
+    U"vector:prepend",
+    U"vector:append",
+    U"vector:insert",
+    U"vector:reverse",
+    U"vector:extract",
+    U"vector:sort",
+    U"vector:@",
+    U"vector:@=",
+    U"vector:>date",
+    U"vector:>time",
+
+    // Weekday words.
+    U"sunday",
+    U"monday",
+    U"tuesday",
+    U"wednesday",
+    U"thursday",
+    U"friday",
+    U"saturday",
+    U"weekday:weekend?",
+    U"weekday:>number",
+  };
+
+  /**
+   * Sequences of stack manipulation words that have no effect, as long as the
+   * stack contains enough values for them.
+   */
+  static const struct
+  {
+    std::u32string_view first;
+    std::u32string_view second;
+    std::size_t depth;
+  } no_op_sequences[] =
+  {
+    { U"dup", U"drop", 1 },
+    { U"swap", U"swap", 2 },
+    { U"over", U"drop", 2 },
+  };
+
+  /**
+   * dup 1 - ( number -- number number )
+   */
+  static bool
+  fused_dup_decrement(class context& context, std::ostream*)
+  {
+    auto& data = context.data;
+
+    if (data.empty() || !data.back().is(value::type::number))
+    {
+      return false;
+    }
+    else if (data.back().is_real())
+    {
+      data.push_back(value::real(data.back().as_real() - 1));
+
+      return true;
+    }
+    else if (data.back().is_integer() || data.back().is_big_integer())
+    {
+      long result;
+
+      if (
+        data.back().is_integer() &&
+        integer::substract(data.back().as_integer(), 1, result)
+      )
+      {
+        data.push_back(result);
+      } else {
+        data.push_back(data.back().substract(1));
+      }
+
+      return true;
+    }
+    try
+    {
+      value result = data.back().as_number() - number(1);
+
+      data.push_back(std::move(result));
+    }
+    catch (const number::unit_error&)
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * 1 - ( number -- number )
+   */
+  static bool
+  fused_decrement(class context& context, std::ostream*)
+  {
+    auto& data = context.data;
+
+    if (data.empty() || !data.back().is(value::type::number))
+    {
+      return false;
+    }
+    else if (data.back().is_real())
+    {
+      data.back() = value::real(data.back().as_real() - 1);
+
+      return true;
+    }
+    else if (data.back().is_integer() || data.back().is_big_integer())
+    {
+      long result;
+
+      if (
+        data.back().is_integer() &&
+        integer::substract(data.back().as_integer(), 1, result)
+      )
+      {
+        data.back() = result;
+      } else {
+        data.back() = data.back().substract(1);
+      }
+
+      return true;
+    }
+    try
+    {
+      data.back() = data.back().as_number() - number(1);
+    }
+    catch (const number::unit_error&)
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * 1 + ( number -- number )
+   */
+  static bool
+  fused_increment(class context& context, std::ostream*)
+  {
+    auto& data = context.data;
+
+    if (data.empty() || !data.back().is(value::type::number))
+    {
+      return false;
+    }
+    else if (data.back().is_real())
+    {
+      data.back() = value::real(data.back().as_real() + 1);
+
+      return true;
+    }
+    else if (data.back().is_integer() || data.back().is_big_integer())
+    {
+      long result;
+
+      if (
+        data.back().is_integer() &&
+        integer::add(data.back().as_integer(), 1, result)
+      )
+      {
+        data.back() = result;
+      } else {
+        data.back() = data.back().add(1);
+      }
+
+      return true;
+    }
+    try
+    {
+      data.back() = data.back().as_number() + number(1);
+    }
+    catch (const number::unit_error&)
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * swap drop ( any any -- any )
+   */
+  static bool
+  fused_swap_drop(class context& context, std::ostream*)
+  {
+    auto& data = context.data;
+    const auto size = data.size();
+
+    if (size < 2)
+    {
+      return false;
+    }
+    data[size - 2] = std::move(data[size - 1]);
+    data.pop_back();
+
+    return true;
+  }
+
+  /**
+   * over over ( any any -- any any any any )
+   */
+  static bool
+  fused_over_over(class context& context, std::ostream*)
+  {
+    auto& data = context.data;
+    const auto size = data.size();
+
+    if (size < 2)
+    {
+      return false;
+    }
+    data.push_back(data[size - 2]);
+    data.push_back(data[size - 1]);
+
+    return true;
+  }
+
+  /**
+   * 0 <> ( any -- boolean )
+   */
+  static bool
+  fused_is_not_zero(class context& context, std::ostream*)
+  {
+    static const value zero = number(0);
+    auto& data = context.data;
+
+    if (data.empty())
+    {
+      return false;
+    }
+    data.back() = data.back() != zero;
+
+    return true;
+  }
+
+  /**
+   * dup . ( any -- any )
+   *
+   * The output is written by the builtin `.` word itself, so that the fused
+   * sequence prints exactly what the unfused one would.
+   */
+  static bool
+  fused_dup_print(class context& context, std::ostream* out)
+  {
+    static const auto print = builtins::find(U".");
+
+    if (!context || !print)
+    {
+      return false;
+    }
+    context.data.push_back(context.data.back());
+    print(context, out);
+
+    return true;
+  }
+
+  /**
+   * Catalogue of word sequences that are fused into single node when they
+   * appear in an quote. When multiple sequences match at the same position,
+   * the one listed first is used, so longer sequences should be listed before
+   * their prefixes. Numbers in the sequences match numeric literals. The
+   * `--ngrams` switch of the command line interpreter can be used to find
+   * out which sequences are worth adding here.
+   */
+  static const struct
+  {
+    std::u32string_view sequence;
+    fused::handler function;
+  } superinstructions[] =
+  {
+    { U"dup 1 -", fused_dup_decrement },
+    { U"dup .", fused_dup_print },
+    { U"swap drop", fused_swap_drop },
+    { U"over over", fused_over_over },
+    { U"0 <>", fused_is_not_zero },
+    { U"1 +", fused_increment },
+    { U"1 -", fused_decrement },
+  };
+
+  bool
+  folded::run(class context& context, std::ostream*) const
+  {
+    if (context.data.size() < depth)
+    {
+      return false;
+    }
+    else if (context.numeric.is_fast())
+    {
+      // Constants are folded with arbitrary precision, but in fast numeric
+      // mode the program expects them as IEEE doubles.
+      for (const auto& value : values)
+      {
+        context.data.push_back(context.numeric.coerce(value));
+      }
+
+      return true;
+    }
+    context.data.insert(
+      std::end(context.data),
+      std::begin(values),
+      std::end(values)
+    );
+
+    return true;
+  }
+
+  bool
+  branch::run(class context& context, std::ostream* out) const
+  {
+    auto& data = context.data;
+    bool condition;
+
+    if (data.empty() || !data.back().is(value::type::boolean))
+    {
+      return false;
+    }
+    condition = data.back().as_boolean();
+    data.pop_back();
+    if (condition)
+    {
+      then_quote.call(context, out);
+    }
+    else if (else_quote)
+    {
+      else_quote->call(context, out);
+    }
+
+    return true;
+  }
+
+  bool
+  loop::run(class context& context, std::ostream* out) const
+  {
+    for (;;)
+    {
+      condition.call(context, out);
+      if (!context.pop().as_boolean())
+      {
+        return true;
+      }
+      body.call(context, out);
+    }
+  }
+
+  bool
+  repeat::run(class context& context, std::ostream* out) const
+  {
+    auto remaining = count < number() ? -count : count;
+
+    while (remaining)
+    {
+      --remaining;
+      body.call(context, out);
+    }
+
+    return true;
+  }
+
+  static bool is_pure_quote(const quote&, node::compiled::guard_container&);
+
+  /**
+   * Tests whether given guards hold in given context.
+   */
+  static bool
+  guards_hold(
+    const class context& context,
+    const node::compiled::guard_container& guards
+  )
+  {
+    for (const auto& guard : guards)
+    {
+      if (guard.word)
+      {
+        const auto word = context.resolve(guard.id);
+
+        if (
+          !word ||
+          !word->is(value::type::quote) ||
+          word->as_quote().target() != guard.word
+        )
+        {
+          return false;
+        }
+      }
+      else if (context.is_defined(guard.id))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Calls given quote with given arguments on the stack and returns the value
+   * it leaves on top of the stack.
+   */
+  static value
+  apply_stage(
+    class context& context,
+    std::ostream* out,
+    const quote& quote,
+    std::initializer_list<const value*> arguments
+  )
+  {
+    for (const auto argument : arguments)
+    {
+      context.data.push_back(*argument);
+    }
+    quote.call(context, out);
+
+    return context.pop();
+  }
+
+  bool
+  pipeline::run(class context& context, std::ostream* out) const
+  {
+    auto& data = context.data;
+    const auto size = data.size();
+    node::compiled::guard_container first_guards;
+    std::optional<value> accumulator;
+    vector result;
+
+    if (
+      size < 2 ||
+      !data[size - 1].is(value::type::vector) ||
+      !data[size - 2].is(value::type::quote)
+    )
+    {
+      return false;
+    }
+
+    // The first quote is only known now, so it's purity has to be checked
+    // here instead of when the pipeline was compiled.
+    const auto first_quote = data[size - 2].as_quote();
+
+    if (
+      !is_pure_quote(first_quote, first_guards) ||
+      !guards_hold(context, first_guards)
+    )
+    {
+      return false;
+    }
+
+    const auto elements = data[size - 1].as_vector();
+    const auto last = stages.back().operation;
+
+    data.resize(size - 2);
+    for (const auto& element : elements)
+    {
+      auto current = element;
+      bool keep = true;
+
+      if (first == operation::map)
+      {
+        current = apply_stage(context, out, first_quote, { &current });
+      } else {
+        keep = apply_stage(
+          context,
+          out,
+          first_quote,
+          { &current }
+        ).as_boolean();
+      }
+      for (const auto& stage : stages)
+      {
+        if (!keep)
+        {
+          break;
+        }
+        switch (stage.operation)
+        {
+          case operation::map:
+            current = apply_stage(context, out, *stage.quote, { &current });
+            break;
+
+          case operation::filter:
+            keep = apply_stage(
+              context,
+              out,
+              *stage.quote,
+              { &current }
+            ).as_boolean();
+            break;
+
+          case operation::reduce:
+            if (accumulator)
+            {
+              accumulator = apply_stage(
+                context,
+                out,
+                *stage.quote,
+                { &*accumulator, &current }
+              );
+            } else {
+              accumulator = current;
+            }
+            break;
+
+          case operation::sum:
+            break;
+        }
+      }
+      if (keep && last != operation::reduce)
+      {
+        result.push_back(current);
+      }
+    }
+
+    if (last == operation::reduce)
+    {
+      if (!accumulator)
+      {
+        throw error(
+          error::type::range,
+          U"Cannot reduce empty vector.",
+          position
+        );
+      }
+      data.push_back(*accumulator);
+    }
+    else if (last == operation::sum)
+    {
+      static const auto sum = builtins::find(U"vector:sum");
+
+      if (result.empty())
+      {
+        throw error(error::type::range, U"Vector is empty.", position);
+      }
+      // The builtin word sums dense magnitudes when it can, so the result
+      // must come from it to be identical with the unfused pipeline.
+      data.push_back(result);
+      sum(context, out);
+    } else {
+      data.push_back(result);
+    }
+
+    return true;
+  }
+
+  bool
+  unchecked::run(class context& context, std::ostream*) const
+  {
+    const auto& data = context.data;
+    const auto size = data.size();
+    const auto count = inputs.size();
+    std::size_t i = 0;
+
+    if (size < count)
+    {
+      return false;
+    }
+    for (; i < count; ++i)
+    {
+      if (inputs[i] && !data[size - count + i].is(*inputs[i]))
+      {
+        return false;
+      }
+    }
+    try
+    {
+      for (i = 0; i < operations.size(); ++i)
+      {
+        operations[i](context);
+      }
+    }
+    catch (const error& e)
+    {
+      // Report position of the word that failed instead of the position of
+      // the whole sequence.
+      throw error(
+        e.type,
+        e.message,
+        nodes[i]->position ? nodes[i]->position : e.position
+      );
+    }
+
+    return true;
+  }
+
+  /**
+   * Returns an context used for evaluating constant expressions.
+   */
+  static class context&
+  scratch_context()
+  {
+    static thread_local class context context;
+
+    return context;
+  }
+
+  static bool
+  is_pure(std::u32string_view id)
+  {
+    static const std::unordered_set<std::u32string_view> words(
+      std::begin(pure_words),
+      std::end(pure_words)
+    );
+
+    return words.find(id) != std::end(words);
+  }
+
+  /**
+   * Tests whether symbol would be pushed onto the stack as number, date or
+   * time when executed, unless it has been defined in the dictionary.
+   */
+  static bool
+  is_literal_symbol(const std::u32string& id)
+  {
+    return number::is_valid(id) || is_date(id) || is_time(id);
+  }
+
+  /**
+   * Tests whether given node always evaluates into the same value as
+   * element of vector or record literal, regardless of the context.
+   */
+  static bool
+  is_constant_expression(const std::shared_ptr<node>& node)
+  {
+    if (!node)
+    {
+      return false;
+    }
+    switch (node->type())
+    {
+      case node::type::literal:
+        return true;
+
+      case node::type::vector_literal:
+        for (const auto& element
+             : std::static_pointer_cast<node::vector_literal>(node)->elements)
+        {
+          if (!is_constant_expression(element))
+          {
+            return false;
+          }
+        }
+
+        return true;
+
+      case node::type::record_literal:
+        for (const auto& property
+             : std::static_pointer_cast<node::record_literal>(node)->properties)
+        {
+          if (!is_constant_expression(property.second))
+          {
+            return false;
+          }
+        }
+
+        return true;
+
+      case node::type::symbol:
+        {
+          const auto& id = std::static_pointer_cast<node::symbol>(node)->id;
+
+          return id == U"true" ||
+            id == U"false" ||
+            is_literal_symbol(id) ||
+            is_month(id) ||
+            is_weekday(id);
+        }
+
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * Largest number of elements in an vector or characters in an string that
+   * is constructed when the quote is compiled. Larger values are left to be
+   * constructed at runtime, so that compiling the quote stays cheap and the
+   * compiled quote does not hold onto large constants.
+   */
+  static const double max_folded_size = 1024;
+
+  /**
+   * Tests whether applying given pure word on the values evaluated so far
+   * would construct an value larger than what is allowed to be folded.
+   */
+  static bool
+  is_too_large(const class context& scratch, const std::u32string& name)
+  {
+    const auto& data = scratch.data;
+    const auto size = data.size();
+    double estimate;
+
+    try
+    {
+      if (name == U"number:range")
+      {
+        if (size < 2
+            || !data[size - 1].is(value::type::number)
+            || !data[size - 2].is(value::type::number))
+        {
+          return false;
+        }
+        estimate = static_cast<double>(data[size - 1])
+          - static_cast<double>(data[size - 2]);
+      }
+      else if (name == U"string:repeat")
+      {
+        if (size < 2
+            || !data[size - 1].is(value::type::string)
+            || !data[size - 2].is(value::type::number))
+        {
+          return false;
+        }
+        // Repeating an empty string still loops given number of times.
+        estimate = static_cast<double>(data[size - 2]) * std::max(
+          static_cast<double>(data[size - 1].as_string().length()),
+          1.0
+        );
+      }
+      else if (name == U"string:pad-start" || name == U"string:pad-end")
+      {
+        if (size < 3 || !data[size - 3].is(value::type::number))
+        {
+          return false;
+        }
+        estimate = static_cast<double>(data[size - 3]);
+      } else {
+        return false;
+      }
+    }
+    catch (const error&)
+    {
+      // The number does not fit into an double, which makes it too large.
+      return true;
+    }
+
+    return !(estimate <= max_folded_size);
+  }
+
+  /**
+   * Attempts to apply builtin word named by given symbol on the values
+   * evaluated so far. Returns `false` and leaves the values untouched if the
+   * word is not pure or if it cannot be applied to them.
+   */
+  static bool
+  apply_pure_word(
+    class context& scratch,
+    const std::u32string& id,
+    node::compiled::guard_container& guards
+  )
+  {
+    std::optional<enum value::type> type;
+    quote::native word = nullptr;
+    std::u32string name;
+
+    // When the type of the topmost value is known, the symbol resolves into
+    // typed builtin word of that type if one exists, just like in `lookup()`.
+    if (scratch)
+    {
+      type = scratch.data.back().type();
+      name = value::type_description(*type) + U":" + id;
+      word = builtins::find(name);
+    }
+    if (!word)
+    {
+      name = id;
+      word = builtins::find(name);
+    }
+    if (!word || !is_pure(name) || is_too_large(scratch, name))
+    {
+      return false;
+    }
+
+    const auto saved = scratch.data;
+
+    try
+    {
+      word(scratch, nullptr);
+    }
+    catch (...)
+    {
+      scratch.data = saved;
+
+      return false;
+    }
+    guards.push_back({ id, type, word });
+
+    return true;
+  }
+
+  /**
+   * Attempts to evaluate given node into constant values. Returns `false` if
+   * it cannot be done. The `worthwhile` flag is set if folding the node saves
+   * some work at runtime.
+   */
+  static bool
+  fold(
+    class context& scratch,
+    const std::shared_ptr<node>& node,
+    node::compiled::guard_container& guards,
+    bool& worthwhile
+  )
+  {
+    switch (node->type())
+    {
+      case node::type::literal:
+        scratch << std::static_pointer_cast<node::literal>(node)->value;
+
+        return true;
+
+      case node::type::vector_literal:
+      case node::type::record_literal:
+        if (!is_constant_expression(node))
+        {
+          return false;
+        }
+        scratch << node->eval(scratch, nullptr);
+        worthwhile = true;
+
+        return true;
+
+      case node::type::symbol:
+        {
+          const auto& id = std::static_pointer_cast<node::symbol>(node)->id;
+
+          if (is_literal_symbol(id))
+          {
+            if (value result; value::parse_number(id, result))
+            {
+              scratch << result;
+            }
+            else if (is_date(id))
+            {
+              scratch << parse_date(id);
+            } else {
+              scratch << parse_time(id);
+            }
+            guards.push_back({ id, std::nullopt, nullptr });
+            worthwhile = true;
+
+            return true;
+          }
+          else if (apply_pure_word(scratch, id, guards))
+          {
+            worthwhile = true;
+
+            return true;
+          }
+        }
+        return false;
+
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * Evaluates sequences of constant values and pure builtin words applied to
+   * them, replacing them with nodes that push the results onto the stack.
+   */
+  static quote::node_container
+  fold_constants(const quote::node_container& nodes)
+  {
+    auto& scratch = scratch_context();
+    quote::node_container result;
+    quote::node_container sequence;
+    node::compiled::guard_container guards;
+    bool worthwhile = false;
+    const auto flush = [&]()
+    {
+      if (worthwhile)
+      {
+        result.push_back(std::make_shared<folded>(
+          std::vector<value>(std::begin(scratch.data), std::end(scratch.data)),
+          0,
+          sequence,
+          guards
+        ));
+      } else {
+        result.insert(
+          std::end(result),
+          std::begin(sequence),
+          std::end(sequence)
+        );
+      }
+      scratch.clear();
+      sequence.clear();
+      guards.clear();
+      worthwhile = false;
+    };
+
+    scratch.clear();
+    for (const auto& node : nodes)
+    {
+      if (node && fold(scratch, node, guards, worthwhile))
+      {
+        sequence.push_back(node);
+        continue;
+      }
+      flush();
+      result.push_back(node);
+    }
+    flush();
+
+    return result;
+  }
+
+  /**
+   * Replaces sequences of stack manipulation words that have no effect with
+   * nodes that only check that the stack contains enough values.
+   */
+  static quote::node_container
+  eliminate_no_ops(const quote::node_container& nodes)
+  {
+    quote::node_container result;
+    const auto size = nodes.size();
+
+    for (quote::node_container::size_type i = 0; i < size; ++i)
+    {
+      const auto& node = nodes[i];
+
+      if (
+        i + 1 < size &&
+        node &&
+        nodes[i + 1] &&
+        node->type() == node::type::symbol &&
+        nodes[i + 1]->type() == node::type::symbol
+      )
+      {
+        const auto& first = std::static_pointer_cast<node::symbol>(node)->id;
+        const auto& second = std::static_pointer_cast<node::symbol>(
+          nodes[i + 1]
+        )->id;
+        bool eliminated = false;
+
+        for (const auto& sequence : no_op_sequences)
+        {
+          if (first == sequence.first && second == sequence.second)
+          {
+            result.push_back(std::make_shared<folded>(
+              std::vector<value>(),
+              sequence.depth,
+              quote::node_container({ node, nodes[i + 1] }),
+              node::compiled::guard_container({
+                { first, std::nullopt, builtins::find(first) },
+                { second, std::nullopt, builtins::find(second) },
+              })
+            ));
+            eliminated = true;
+            break;
+          }
+        }
+        if (eliminated)
+        {
+          ++i;
+          continue;
+        }
+      }
+      result.push_back(node);
+    }
+
+    return result;
+  }
+
+  static void
+  unchecked_dup(class context& context)
+  {
+    context.data.push_back(context.data.back());
+  }
+
+  static void
+  unchecked_drop(class context& context)
+  {
+    context.data.pop_back();
+  }
+
+  static void
+  unchecked_nip(class context& context)
+  {
+    auto& data = context.data;
+
+    data[data.size() - 2] = std::move(data.back());
+    data.pop_back();
+  }
+
+  static void
+  unchecked_over(class context& context)
+  {
+    auto& data = context.data;
+
+    data.push_back(data[data.size() - 2]);
+  }
+
+  static void
+  unchecked_rot(class context& context)
+  {
+    auto& data = context.data;
+    const auto size = data.size();
+
+    std::rotate(
+      std::begin(data) + (size - 3),
+      std::begin(data) + (size - 2),
+      std::end(data)
+    );
+  }
+
+  static void
+  unchecked_swap(class context& context)
+  {
+    auto& data = context.data;
+    const auto size = data.size();
+
+    std::swap(data[size - 1], data[size - 2]);
+  }
+
+  static void
+  unchecked_tuck(class context& context)
+  {
+    auto& data = context.data;
+    const auto size = data.size();
+
+    std::swap(data[size - 1], data[size - 2]);
+    data.push_back(data[size - 2]);
+  }
+
+  template<value (value::*method)(const value&) const>
+  static void
+  unchecked_arithmetic(class context& context)
+  {
+    auto& data = context.data;
+    const auto b = std::move(data.back());
+
+    data.pop_back();
+    data.back() = context.numeric.coerce((data.back().*method)(b));
+  }
+
+  template<class Compare>
+  static void
+  unchecked_comparison(class context& context)
+  {
+    auto& data = context.data;
+    const auto b = std::move(data.back());
+
+    data.pop_back();
+    data.back() = Compare()(data.back(), b);
+  }
+
+  /**
+   * Builtin words that can be executed without checking the stack, once the
+   * stack has been found to contain enough values for the whole sequence of
+   * words.
+   */
+  static const struct
+  {
+    std::u32string_view id;
+    unchecked::operation operation;
+  } unchecked_words[] =
+  {
+    { U"dup", unchecked_dup },
+    { U"drop", unchecked_drop },
+    { U"nip", unchecked_nip },
+    { U"over", unchecked_over },
+    { U"rot", unchecked_rot },
+    { U"swap", unchecked_swap },
+    { U"tuck", unchecked_tuck },
+    { U"+", unchecked_arithmetic<&value::add> },
+    { U"-", unchecked_arithmetic<&value::substract> },
+    { U"*", unchecked_arithmetic<&value::multiply> },
+    { U"/", unchecked_arithmetic<&value::divide> },
+    { U"%", unchecked_arithmetic<&value::modulo> },
+    { U"=", unchecked_comparison<std::equal_to<value>> },
+    { U"<>", unchecked_comparison<std::not_equal_to<value>> },
+    { U"<", unchecked_comparison<std::less<value>> },
+    { U">", unchecked_comparison<std::greater<value>> },
+    { U"<=", unchecked_comparison<std::less_equal<value>> },
+    { U">=", unchecked_comparison<std::greater_equal<value>> },
+  };
+
+  static unchecked::operation
+  find_unchecked(const std::shared_ptr<node>& node)
+  {
+    if (!node || node->type() != node::type::symbol)
+    {
+      return nullptr;
+    }
+
+    const auto& id = std::static_pointer_cast<node::symbol>(node)->id;
+
+    for (const auto& word : unchecked_words)
+    {
+      if (id == word.id)
+      {
+        return word.operation;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * Replaces sequences of stack manipulation words and operators with nodes
+   * that check the stack only once, when the stack effect of the sequence
+   * can be inferred statically.
+   */
+  static quote::node_container
+  elide_checks(const quote::node_container& nodes)
+  {
+    quote::node_container result;
+    const auto size = nodes.size();
+
+    for (quote::node_container::size_type i = 0; i < size;)
+    {
+      std::vector<unchecked::operation> operations;
+      auto j = i;
+
+      while (j < size)
+      {
+        if (const auto operation = find_unchecked(nodes[j]))
+        {
+          operations.push_back(operation);
+          ++j;
+        } else {
+          break;
+        }
+      }
+
+      // Single word gains nothing, as it checks the stack only once anyway.
+      if (operations.size() < 2)
+      {
+        result.push_back(nodes[i]);
+        ++i;
+        continue;
+      }
+
+      const quote::node_container sequence(
+        std::begin(nodes) + i,
+        std::begin(nodes) + j
+      );
+      std::optional<effect> inferred;
+
+      try
+      {
+        inferred = effect::infer(quote(sequence), scratch_context());
+      }
+      catch (const error&)
+      {
+        // The sequence is certain to fail, so let the original nodes report
+        // the error.
+      }
+      if (inferred)
+      {
+        node::compiled::guard_container guards;
+
+        for (const auto& node : sequence)
+        {
+          const auto& id = std::static_pointer_cast<node::symbol>(node)->id;
+
+          guards.push_back({ id, std::nullopt, builtins::find(id) });
+        }
+        result.push_back(std::make_shared<unchecked>(
+          inferred->inputs,
+          operations,
+          sequence,
+          guards
+        ));
+      } else {
+        result.insert(
+          std::end(result),
+          std::begin(sequence),
+          std::end(sequence)
+        );
+      }
+      i = j;
+    }
+
+    return result;
+  }
+
+  /**
+   * Returns the symbol that given node has been constructed from, if it's an
+   * symbol or an constant folded from single symbol.
+   */
+  static const std::u32string*
+  fusable_id(const std::shared_ptr<node>& node)
+  {
+    if (!node)
+    {
+      return nullptr;
+    }
+    else if (node->type() == node::type::symbol)
+    {
+      return &std::static_pointer_cast<node::symbol>(node)->id;
+    }
+    else if (const auto f = std::dynamic_pointer_cast<folded>(node))
+    {
+      if (
+        f->depth == 0 &&
+        f->nodes.size() == 1 &&
+        f->nodes[0] &&
+        f->nodes[0]->type() == node::type::symbol
+      )
+      {
+        return &std::static_pointer_cast<node::symbol>(f->nodes[0])->id;
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * Splits the word sequences of the superinstruction catalogue into
+   * individual words.
+   */
+  static std::vector<std::vector<std::u32string>>
+  split_superinstructions()
+  {
+    std::vector<std::vector<std::u32string>> result;
+
+    for (const auto& entry : superinstructions)
+    {
+      std::vector<std::u32string> words;
+      std::u32string_view::size_type begin = 0;
+
+      while (begin < entry.sequence.length())
+      {
+        auto end = entry.sequence.find(U' ', begin);
+
+        if (end == std::u32string_view::npos)
+        {
+          end = entry.sequence.length();
+        }
+        words.emplace_back(entry.sequence.substr(begin, end - begin));
+        begin = end + 1;
+      }
+      result.push_back(words);
+    }
+
+    return result;
+  }
+
+  /**
+   * Replaces sequences of words listed in the superinstruction catalogue
+   * with fused nodes.
+   */
+  static quote::node_container
+  fuse_superinstructions(const quote::node_container& nodes)
+  {
+    static const auto catalogue = split_superinstructions();
+    quote::node_container result;
+    const auto size = nodes.size();
+
+    for (quote::node_container::size_type i = 0; i < size;)
+    {
+      bool matched = false;
+
+      for (std::size_t j = 0; j < catalogue.size() && !matched; ++j)
+      {
+        const auto& words = catalogue[j];
+        const auto length = words.size();
+        node::compiled::guard_container guards;
+        bool after_number = false;
+
+        if (i + length > size)
+        {
+          continue;
+        }
+        matched = true;
+        for (std::size_t k = 0; k < length && matched; ++k)
+        {
+          const auto& node = nodes[i + k];
+          const auto id = fusable_id(node);
+
+          if (!id || *id != words[k])
+          {
+            matched = false;
+          }
+          else if (node->type() == node::type::compiled)
+          {
+            const auto& folded_guards = std::static_pointer_cast<
+              node::compiled
+            >(node)->guards;
+
+            guards.insert(
+              std::end(guards),
+              std::begin(folded_guards),
+              std::end(folded_guards)
+            );
+            after_number = number::is_valid(*id);
+          }
+          else if (is_literal_symbol(*id))
+          {
+            guards.push_back({ *id, std::nullopt, nullptr });
+            after_number = number::is_valid(*id);
+          } else {
+            const auto word = builtins::find(*id);
+
+            if (!word)
+            {
+              matched = false;
+              break;
+            }
+            guards.push_back({
+              *id,
+              after_number
+                ? std::make_optional(value::type::number)
+                : std::nullopt,
+              word
+            });
+            after_number = false;
+          }
+        }
+        if (matched)
+        {
+          result.push_back(std::make_shared<fused>(
+            superinstructions[j].function,
+            quote::node_container(
+              std::begin(nodes) + i,
+              std::begin(nodes) + i + length
+            ),
+            guards
+          ));
+          i += length;
+        }
+      }
+      if (!matched)
+      {
+        result.push_back(nodes[i++]);
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Returns the quote contained in given node, if it's an literal quote.
+   */
+  static const quote*
+  quote_literal(const std::shared_ptr<node>& node)
+  {
+    if (node && node->type() == node::type::literal)
+    {
+      const auto& value = std::static_pointer_cast<node::literal>(node)->value;
+
+      if (value.is(value::type::quote))
+      {
+        return &value.as_quote();
+      }
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * Returns identifier of the symbol contained in given node, if it's an
+   * symbol.
+   */
+  static const std::u32string*
+  symbol_id(const std::shared_ptr<node>& node)
+  {
+    if (node && node->type() == node::type::symbol)
+    {
+      return &std::static_pointer_cast<node::symbol>(node)->id;
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * Attempts to lower control flow word at given offset, along with the
+   * literal quotes preceding it. Returns number of nodes consumed, or zero if
+   * the nodes at given offset cannot be lowered.
+   */
+  static quote::node_container::size_type
+  lower_control_flow_at(
+    const quote::node_container& nodes,
+    quote::node_container::size_type i,
+    quote::node_container& result
+  )
+  {
+    const auto size = nodes.size();
+    const auto first = quote_literal(nodes[i]);
+
+    if (!first || i + 1 >= size)
+    {
+      return 0;
+    }
+
+    // ( then ) if
+    if (const auto id = symbol_id(nodes[i + 1]); id && *id == U"if")
+    {
+      result.push_back(std::make_shared<branch>(
+        *first,
+        std::nullopt,
+        quote::node_container(std::begin(nodes) + i, std::begin(nodes) + i + 2),
+        node::compiled::guard_container({
+          { *id, value::type::quote, builtins::find(*id) },
+        }),
+        nodes[i + 1]->position
+      ));
+
+      return 2;
+    }
+
+    if (i + 2 >= size)
+    {
+      return 0;
+    }
+
+    const auto id = symbol_id(nodes[i + 2]);
+    const auto quote_nodes = quote::node_container(
+      std::begin(nodes) + i,
+      std::begin(nodes) + i + 3
+    );
+
+    if (!id)
+    {
+      return 0;
+    }
+
+    // ( then ) ( else ) if-else
+    // ( condition ) ( body ) while
+    if (const auto second = quote_literal(nodes[i + 1]))
+    {
+      const node::compiled::guard_container guards({
+        { *id, value::type::quote, builtins::find(*id) },
+      });
+
+      if (*id == U"if-else")
+      {
+        result.push_back(std::make_shared<branch>(
+          *first,
+          *second,
+          quote_nodes,
+          guards,
+          nodes[i + 2]->position
+        ));
+
+        return 3;
+      }
+      else if (*id == U"while")
+      {
+        result.push_back(std::make_shared<loop>(
+          *first,
+          *second,
+          quote_nodes,
+          guards,
+          nodes[i + 2]->position
+        ));
+
+        return 3;
+      }
+    }
+
+    // ( body ) count number:times
+    if (*id == U"times" || *id == U"number:times")
+    {
+      const auto count = symbol_id(nodes[i + 1]);
+
+      if (count && number::is_valid(*count))
+      {
+        result.push_back(std::make_shared<repeat>(
+          *first,
+          number::parse(*count),
+          quote_nodes,
+          node::compiled::guard_container({
+            { *count, std::nullopt, nullptr },
+            { *id, value::type::number, builtins::find(U"number:times") },
+          }),
+          nodes[i + 2]->position
+        ));
+
+        return 3;
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * Tests whether given quote consists only of constants and pure builtin
+   * words, and collects the assumptions about symbol resolution made by the
+   * test into given container.
+   */
+  static bool
+  is_pure_quote(
+    const quote& quote,
+    node::compiled::guard_container& guards
+  )
+  {
+    if (quote.is_native() || quote.is_scoped())
+    {
+      return false;
+    }
+    for (const auto& node : quote.nodes())
+    {
+      if (!node)
+      {
+        continue;
+      }
+      else if (node->type() != node::type::symbol)
+      {
+        if (!is_constant_expression(node))
+        {
+          return false;
+        }
+        continue;
+      }
+
+      const auto& id = std::static_pointer_cast<node::symbol>(node)->id;
+
+      if (is_literal_symbol(id))
+      {
+        guards.push_back({ id, std::nullopt, nullptr });
+      }
+      else if (const auto word = builtins::find(id); word && is_pure(id))
+      {
+        guards.push_back({ id, std::nullopt, word });
+      } else {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Returns the operation of an `vector:map`, `vector:filter`,
+   * `vector:reduce` or `vector:sum` call, with or without the type prefix.
+   */
+  static std::optional<pipeline::operation>
+  pipeline_operation(const std::u32string& id)
+  {
+    static const std::u32string_view prefix = U"vector:";
+    const auto name = id.compare(0, prefix.length(), prefix)
+      ? std::u32string_view(id)
+      : std::u32string_view(id).substr(prefix.length());
+
+    if (name == U"map")
+    {
+      return pipeline::operation::map;
+    }
+    else if (name == U"filter")
+    {
+      return pipeline::operation::filter;
+    }
+    else if (name == U"reduce")
+    {
+      return pipeline::operation::reduce;
+    }
+    else if (name == U"sum")
+    {
+      return pipeline::operation::sum;
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * Returns the builtin word that implements given pipeline operation.
+   */
+  static quote::native
+  pipeline_word(pipeline::operation operation)
+  {
+    switch (operation)
+    {
+      case pipeline::operation::map:
+        return builtins::find(U"vector:map");
+
+      case pipeline::operation::filter:
+        return builtins::find(U"vector:filter");
+
+      case pipeline::operation::reduce:
+        return builtins::find(U"vector:reduce");
+
+      case pipeline::operation::sum:
+        return builtins::find(U"vector:sum");
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * Attempts to fuse chain of vector operations beginning from given offset.
+   * Returns number of nodes consumed, or zero if there is nothing to fuse.
+   */
+  static quote::node_container::size_type
+  fuse_pipeline_at(
+    const quote::node_container& nodes,
+    quote::node_container::size_type i,
+    quote::node_container& result
+  )
+  {
+    const auto size = nodes.size();
+    const auto first_id = symbol_id(nodes[i]);
+    std::optional<pipeline::operation> first;
+    std::vector<pipeline::stage> stages;
+    node::compiled::guard_container guards;
+    auto j = i + 1;
+
+    if (
+      !first_id ||
+      !(first = pipeline_operation(*first_id)) ||
+      (*first != pipeline::operation::map &&
+       *first != pipeline::operation::filter)
+    )
+    {
+      return 0;
+    }
+    guards.push_back({ *first_id, value::type::vector, pipeline_word(*first) });
+
+    while (j < size)
+    {
+      // vector:sum
+      if (const auto id = symbol_id(nodes[j]))
+      {
+        const auto operation = pipeline_operation(*id);
+
+        if (operation && *operation == pipeline::operation::sum)
+        {
+          guards.push_back({
+            *id,
+            value::type::vector,
+            pipeline_word(*operation)
+          });
+          stages.push_back({ *operation, std::nullopt });
+          ++j;
+        }
+        break;
+      }
+
+      // ( quote ) swap vector:map
+      const auto quote = quote_literal(nodes[j]);
+
+      if (!quote || j + 2 >= size)
+      {
+        break;
+      }
+
+      const auto swap = symbol_id(nodes[j + 1]);
+      const auto id = symbol_id(nodes[j + 2]);
+      std::optional<pipeline::operation> operation;
+      node::compiled::guard_container quote_guards;
+
+      if (
+        !swap ||
+        *swap != U"swap" ||
+        !id ||
+        !(operation = pipeline_operation(*id)) ||
+        *operation == pipeline::operation::sum ||
+        !is_pure_quote(*quote, quote_guards)
+      )
+      {
+        break;
+      }
+      guards.push_back({ *swap, std::nullopt, builtins::find(*swap) });
+      guards.push_back({ *id, value::type::vector, pipeline_word(*operation) });
+      guards.insert(
+        std::end(guards),
+        std::begin(quote_guards),
+        std::end(quote_guards)
+      );
+      stages.push_back({ *operation, *quote });
+      j += 3;
+      if (*operation == pipeline::operation::reduce)
+      {
+        break;
+      }
+    }
+
+    if (stages.empty())
+    {
+      return 0;
+    }
+    result.push_back(std::make_shared<pipeline>(
+      *first,
+      stages,
+      quote::node_container(std::begin(nodes) + i, std::begin(nodes) + j),
+      guards,
+      nodes[j - 1]->position
+    ));
+
+    return j - i;
+  }
+
+  /**
+   * Fuses chains of `vector:map`, `vector:filter` and `vector:reduce` calls
+   * into single pass over the vector.
+   */
+  static quote::node_container
+  fuse_pipelines(const quote::node_container& nodes)
+  {
+    quote::node_container result;
+    const auto size = nodes.size();
+
+    for (quote::node_container::size_type i = 0; i < size;)
+    {
+      if (const auto consumed = fuse_pipeline_at(nodes, i, result))
+      {
+        i += consumed;
+      } else {
+        result.push_back(nodes[i++]);
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Replaces `if`, `if-else`, `while` and `number:times` with dedicated
+   * nodes when their quotes are given as literals, so that the quotes don't
+   * have to be pushed onto the stack and popped from there again.
+   */
+  static quote::node_container
+  lower_control_flow(const quote::node_container& nodes)
+  {
+    quote::node_container result;
+    const auto size = nodes.size();
+
+    for (quote::node_container::size_type i = 0; i < size;)
+    {
+      if (const auto consumed = lower_control_flow_at(nodes, i, result))
+      {
+        i += consumed;
+      } else {
+        result.push_back(nodes[i++]);
+      }
+    }
+
+    return result;
+  }
+
+  quote::node_container
+  optimize(const quote::node_container& nodes)
+  {
+    // Control flow is lowered and vector operations fused first, as constant
+    // folding would otherwise merge the literal quotes with surrounding
+    // constants.
+    return elide_checks(
+      eliminate_no_ops(
+        fuse_superinstructions(
+          fold_constants(fuse_pipelines(lower_control_flow(nodes)))
+        )
+      )
+    );
+  }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "laskin/parse_cache.hpp"
+
+namespace laskin
+{
+  parse_cache::parse_cache(std::size_t capacity)
+    : m_capacity(capacity)
+    , m_hits(0)
+    , m_misses(0) {}
+
+  const std::shared_ptr<parse_cache>&
+  parse_cache::shared()
+  {
+    static thread_local const auto instance = std::make_shared<parse_cache>();
+
+    return instance;
+  }
+
+  quote
+  parse_cache::parse(const std::u32string& source)
+  {
+    const auto index = m_index.find(source);
+
+    if (index != std::end(m_index))
+    {
+      ++m_hits;
+      m_entries.splice(std::begin(m_entries), m_entries, index->second);
+
+      return index->second->second;
+    }
+    ++m_misses;
+
+    const auto result = quote::parse(source);
+
+    if (m_capacity > 0)
+    {
+      m_entries.emplace_front(source, result);
+      m_index.emplace(m_entries.front().first, std::begin(m_entries));
+      trim();
+    }
+
+    return result;
+  }
+
+  std::size_t
+  parse_cache::capacity() const
+  {
+    return m_capacity;
+  }
+
+  void
+  parse_cache::resize(std::size_t capacity)
+  {
+    m_capacity = capacity;
+    trim();
+  }
+
+  void
+  parse_cache::clear()
+  {
+    m_index.clear();
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+  }
+
+  std::size_t
+  parse_cache::hits() const
+  {
+    return m_hits;
+  }
+
+  std::size_t
+  parse_cache::misses() const
+  {
+    return m_misses;
+  }
+
+  void
+  parse_cache::trim()
+  {
+    while (m_entries.size() > m_capacity)
+    {
+      m_index.erase(m_entries.back().first);
+      m_entries.pop_back();
+    }
+  }
+}
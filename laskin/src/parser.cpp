@@ -23,6 +23,8 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <algorithm>
+
 #include <peelo/unicode/ctype/isgraph.hpp>
 #include <peelo/unicode/ctype/isspace.hpp>
 #include <peelo/unicode/ctype/isvalid.hpp>
@@ -34,11 +36,25 @@
 
 namespace laskin
 {
+  /**
+   * Local variables of an quote being parsed.
+   */
+  struct lexical_scope
+  {
+    /** Variables declared in the quote so far, if any. */
+    std::shared_ptr<class scope> scope;
+    /** Whether the quote refers to variables of an enclosing quote. */
+    bool captures;
+  };
+
   struct state
   {
     struct position position;
     std::u32string::const_iterator pos;
     std::u32string::const_iterator end;
+    std::vector<lexical_scope> scopes;
+    /** Source code being parsed, when parsing of quotes is deferred. */
+    std::shared_ptr<const std::u32string> source;
   };
 
   static std::shared_ptr<node> parse(struct state&, bool);
@@ -461,27 +477,15 @@ namespace laskin
     return std::make_shared<node::record_literal>(properties, position);
   }
 
-  static std::shared_ptr<node::literal>
-  parse_quote_literal(struct state& state)
+  /**
+   * Parses contents of an quote literal after the opening parenthesis, up to
+   * and including the closing parenthesis.
+   */
+  static quote::node_container
+  parse_quote_body(struct state& state, const struct position& position)
   {
-    struct position position;
-
     quote::node_container nodes;
 
-    skip_whitespace(state);
-    position = state.position;
-
-    if (!peek_read(state, U'('))
-    {
-      throw error(
-        error::type::syntax,
-        std::u32string(U"Unexpected ") +
-        (eof(state) ? U"end of input" : U"input") +
-        U"; Missing quote literal.",
-        position
-      );
-    }
-
     skip_whitespace(state);
 
     if (!peek_read(state, U')'))
@@ -505,6 +509,138 @@ namespace laskin
       }
     }
 
+    return nodes;
+  }
+
+  /**
+   * Skips over contents of an quote literal after the opening parenthesis, up
+   * to and including the closing parenthesis, without parsing them. Only
+   * brackets, string literals and comments are recognized.
+   */
+  static void
+  skip_quote_body(struct state& state, const struct position& position)
+  {
+    std::u32string brackets;
+
+    for (;;)
+    {
+      skip_whitespace(state);
+      if (eof(state))
+      {
+        throw error(
+          error::type::syntax,
+          U"Unterminated quote literal; Missing `)'.",
+          position
+        );
+      }
+
+      const auto c = peek(state);
+
+      if (c == U'"' || c == U'\'')
+      {
+        parse_string(state);
+      }
+      else if (c == U'(' || c == U'[' || c == U'{')
+      {
+        brackets.push_back(read(state));
+      }
+      else if (c == U')' || c == U']' || c == U'}')
+      {
+        read(state);
+        if (brackets.empty())
+        {
+          if (c == U')')
+          {
+            return;
+          }
+        } else {
+          brackets.pop_back();
+        }
+      }
+      else if (issymbol(c))
+      {
+        do
+        {
+          read(state);
+        }
+        while (peek(state, issymbol));
+      } else {
+        read(state);
+      }
+    }
+  }
+
+  /**
+   * Tests whether local variables have been declared in any of the quotes
+   * being parsed.
+   */
+  static bool
+  has_visible_locals(const struct state& state)
+  {
+    for (const auto& scope : state.scopes)
+    {
+      if (scope.scope && !scope.scope->names.empty())
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  static std::shared_ptr<node>
+  parse_quote_literal(struct state& state)
+  {
+    struct position position;
+    quote::node_container nodes;
+    bool captures;
+
+    skip_whitespace(state);
+    position = state.position;
+
+    if (!peek_read(state, U'('))
+    {
+      throw error(
+        error::type::syntax,
+        std::u32string(U"Unexpected ") +
+        (eof(state) ? U"end of input" : U"input") +
+        U"; Missing quote literal.",
+        position
+      );
+    }
+
+    // Quotes that might refer to local variables of enclosing quotes have to
+    // be parsed right away, as the variables must be resolved in the scopes
+    // as they are at this point.
+    if (state.source && !has_visible_locals(state))
+    {
+      const auto begin = std::begin(*state.source);
+      const auto offset = state.pos - begin;
+      const auto body_position = state.position;
+
+      skip_quote_body(state, position);
+
+      return std::make_shared<node::literal>(
+        quote(std::make_shared<quote::deferred>(
+          state.source,
+          offset,
+          state.pos - begin,
+          body_position
+        )),
+        position
+      );
+    }
+
+    state.scopes.push_back({ nullptr, false });
+    nodes = parse_quote_body(state, position);
+    captures = state.scopes.back().captures;
+    state.scopes.pop_back();
+
+    if (captures)
+    {
+      return std::make_shared<node::closure>(quote(nodes), position);
+    }
+
     return std::make_shared<node::literal>(quote(nodes), position);
   }
 
@@ -533,6 +669,110 @@ namespace laskin
     return buffer;
   }
 
+  /**
+   * Parses declaration of local variables, `-> ( a b )`, after the arrow.
+   * Variables already declared in the same quote are assigned new values
+   * instead of being declared again.
+   */
+  static std::shared_ptr<node::binding>
+  parse_binding(struct state& state, const struct position& position)
+  {
+    auto& current = state.scopes.back();
+    node::binding::container_type slots;
+
+    read(state);
+    for (;;)
+    {
+      skip_whitespace(state);
+      if (eof(state))
+      {
+        throw error(
+          error::type::syntax,
+          U"Unterminated declaration of local variables; Missing `)'.",
+          position
+        );
+      }
+      else if (peek_read(state, U')'))
+      {
+        break;
+      } else {
+        const auto id = parse_symbol_string(state);
+
+        if (!current.scope)
+        {
+          current.scope = std::make_shared<class scope>();
+        }
+
+        auto& names = current.scope->names;
+        const auto existing = std::find(std::begin(names), std::end(names), id);
+
+        if (existing != std::end(names))
+        {
+          slots.push_back(std::distance(std::begin(names), existing));
+        } else {
+          slots.push_back(names.size());
+          names.push_back(id);
+        }
+      }
+    }
+
+    if (slots.empty())
+    {
+      throw error(
+        error::type::syntax,
+        U"Missing local variables in declaration.",
+        position
+      );
+    }
+
+    return std::make_shared<node::binding>(current.scope, slots, position);
+  }
+
+  /**
+   * Resolves given symbol into local variable declared in the quote being
+   * parsed or in one of the quotes enclosing it. Returns null pointer if
+   * there is no such variable.
+   */
+  static std::shared_ptr<node::local>
+  parse_local(
+    struct state& state,
+    const std::u32string& id,
+    const struct position& position
+  )
+  {
+    for (auto i = state.scopes.size(); i > 0; --i)
+    {
+      const auto& variables = state.scopes[i - 1].scope;
+
+      if (!variables)
+      {
+        continue;
+      }
+
+      const auto& names = variables->names;
+      const auto entry = std::find(std::begin(names), std::end(names), id);
+
+      if (entry != std::end(names))
+      {
+        // Quotes between the declaration and the reference have to capture
+        // activation frame of the declaring quote when they are evaluated.
+        for (auto j = i; j < state.scopes.size(); ++j)
+        {
+          state.scopes[j].captures = true;
+        }
+
+        return std::make_shared<node::local>(
+          id,
+          variables,
+          std::distance(std::begin(names), entry),
+          position
+        );
+      }
+    }
+
+    return nullptr;
+  }
+
   static std::shared_ptr<node>
   parse_symbol(struct state& state, bool allow_definition)
   {
@@ -543,8 +783,6 @@ namespace laskin
     position = state.position;
     if ((id = parse_symbol_string(state)) == U"->")
     {
-      const auto symbol = parse_symbol_string(state);
-
       if (!allow_definition)
       {
         throw error(
@@ -554,7 +792,25 @@ namespace laskin
         );
       }
 
-      return std::make_shared<node::definition>(symbol, position);
+      skip_whitespace(state);
+      if (peek(state, U'('))
+      {
+        return parse_binding(state, position);
+      }
+
+      return std::make_shared<node::definition>(
+        parse_symbol_string(state),
+        position
+      );
+    }
+    else if (allow_definition)
+    {
+      // Local variables are not visible to elements of vector and record
+      // literals, which do not perform dictionary lookups either.
+      if (const auto local = parse_local(state, id, position))
+      {
+        return local;
+      }
     }
 
     return std::make_shared<node::symbol>(id, position);
@@ -594,22 +850,49 @@ namespace laskin
     }
   }
 
+  const quote::node_container&
+  quote::deferred::nodes()
+  {
+    if (!m_nodes)
+    {
+      struct state state =
+      {
+        position,
+        std::begin(*source) + begin,
+        std::begin(*source) + end,
+        { { nullptr, false } },
+        source,
+      };
+
+      m_nodes = parse_quote_body(state, position);
+    }
+
+    return *m_nodes;
+  }
+
   quote
   quote::parse(
     const std::u32string& source,
     const std::optional<std::filesystem::path>& path,
     int line,
-    int column
+    int column,
+    bool lazy
   )
   {
+    const auto shared_source = lazy
+      ? std::make_shared<const std::u32string>(source)
+      : nullptr;
     struct state state =
     {
       { path, line, column },
-      std::begin(source),
-      std::end(source),
+      shared_source ? std::begin(*shared_source) : std::begin(source),
+      shared_source ? std::end(*shared_source) : std::end(source),
+      {},
+      shared_source,
     };
     quote::node_container nodes;
 
+    state.scopes.push_back({ nullptr, false });
     for (;;)
     {
       skip_whitespace(state);
@@ -628,7 +911,8 @@ namespace laskin
     const std::string& source,
     const std::optional<std::filesystem::path>& path,
     int line,
-    int column
+    int column,
+    bool lazy
   )
   {
     using peelo::unicode::encoding::utf8::decode_validate;
@@ -643,7 +927,7 @@ namespace laskin
       );
     }
 
-    return parse(decoded_source, path, line, column);
+    return parse(decoded_source, path, line, column, lazy);
   }
 
   quote
@@ -651,7 +935,8 @@ namespace laskin
     std::istream& input,
     const std::optional<std::filesystem::path>& path,
     int line,
-    int column
+    int column,
+    bool lazy
   )
   {
     return parse(
@@ -661,7 +946,8 @@ namespace laskin
       ),
       path,
       line,
-      column
+      column,
+      lazy
     );
   }
 }
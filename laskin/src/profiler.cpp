@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+
+#include "laskin/profiler.hpp"
+
+namespace laskin
+{
+  profiler::profiler(std::size_t max_length)
+    : m_max_length(max_length) {}
+
+  void
+  profiler::record(
+    const quote::node_container& nodes,
+    quote::node_container::size_type offset
+  )
+  {
+    const auto size = nodes.size();
+    std::u32string sequence;
+
+    // Only sequences consisting entirely of symbols are recorded, as those
+    // are the only ones that can be fused together.
+    for (auto i = offset; i < size && i - offset < m_max_length; ++i)
+    {
+      const auto& node = nodes[i];
+
+      if (!node || node->type() != node::type::symbol)
+      {
+        break;
+      }
+      if (i > offset)
+      {
+        sequence.append(1, U' ');
+      }
+      sequence.append(std::static_pointer_cast<node::symbol>(node)->id);
+      if (i > offset)
+      {
+        ++m_counters[sequence];
+      }
+    }
+  }
+
+  profiler::result_type
+  profiler::most_frequent(std::size_t count) const
+  {
+    result_type result(std::begin(m_counters), std::end(m_counters));
+
+    std::sort(
+      std::begin(result),
+      std::end(result),
+      [](const auto& a, const auto& b)
+      {
+        if (a.second != b.second)
+        {
+          return a.second > b.second;
+        }
+
+        return a.first < b.first;
+      }
+    );
+    if (result.size() > count)
+    {
+      result.resize(count);
+    }
+
+    return result;
+  }
+}
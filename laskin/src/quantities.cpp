@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <exception>
+#include <future>
+#include <system_error>
+#include <thread>
+
+#include "laskin/numeric.hpp"
+#include "laskin/quantities.hpp"
+
+namespace laskin
+{
+  /**
+   * Largest integer below which all integers are exactly representable as
+   * doubles.
+   */
+  static const long max_exact_integer = 1L << DBL_MANT_DIG;
+
+  std::optional<quantities>
+  quantities::extract(const vector& elements, bool integers)
+  {
+    quantities result;
+    bool only_integers = !integers;
+
+    if (elements.empty() || !numeric::is_double_precision())
+    {
+      return std::nullopt;
+    }
+    result.magnitudes.reserve(elements.size());
+    for (const auto& element : elements)
+    {
+      units::id unit;
+      double magnitude;
+      bool real;
+
+      if (!extract(element, unit, magnitude, real))
+      {
+        return std::nullopt;
+      }
+      else if (result.magnitudes.empty())
+      {
+        result.unit = unit;
+        result.real = real;
+      }
+      else if (unit != result.unit)
+      {
+        return std::nullopt;
+      }
+      result.real = result.real || real;
+      only_integers = only_integers && element.is_integer();
+      result.magnitudes.push_back(magnitude);
+    }
+    if (only_integers)
+    {
+      return std::nullopt;
+    }
+
+    return result;
+  }
+
+  bool
+  quantities::extract(
+    const value& value,
+    units::id& unit,
+    double& magnitude,
+    bool& real
+  )
+  {
+    if (!value.is(value::type::number) || value.is_big_integer())
+    {
+      return false;
+    }
+    else if (value.is_integer())
+    {
+      const auto integer = value.as_integer();
+
+      if (integer <= -max_exact_integer || integer >= max_exact_integer)
+      {
+        return false;
+      }
+      unit = units::none;
+      magnitude = static_cast<double>(integer);
+      real = false;
+
+      return true;
+    }
+    else if (value.is_real())
+    {
+      unit = units::none;
+      magnitude = value.as_real();
+      real = true;
+
+      return is_exact(magnitude);
+    }
+
+    const auto& number = value.as_number();
+
+    try
+    {
+      magnitude = double(number);
+    }
+    catch (const std::exception&)
+    {
+      return false;
+    }
+    unit = value.unit_id();
+    real = false;
+
+    return is_exact(magnitude);
+  }
+
+  bool
+  quantities::is_exact(double magnitude)
+  {
+    return std::isfinite(magnitude)
+      && (magnitude == 0.0 || std::fabs(magnitude) >= DBL_MIN);
+  }
+
+  value
+  quantities::box(double magnitude) const
+  {
+    if (const auto measurement_unit = units::get(unit))
+    {
+      return number(magnitude, *measurement_unit);
+    }
+    else if (real)
+    {
+      return value::real(magnitude);
+    }
+
+    return magnitude;
+  }
+
+  vector
+  quantities::box() const
+  {
+    const auto measurement_unit = units::get(unit);
+    vector result;
+
+    result.reserve(magnitudes.size());
+    for (const auto magnitude : magnitudes)
+    {
+      if (measurement_unit)
+      {
+        result.push_back(number(magnitude, *measurement_unit));
+      } else {
+        result.push_back(real ? value::real(magnitude) : value(magnitude));
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * Number of magnitudes below which the magnitudes are summed sequentially
+   * instead of splitting them into halves.
+   */
+  static const quantities::size_type pairwise_block_size = 128;
+
+  /**
+   * Number of magnitudes below which halves of an sum are no longer computed
+   * in separate threads.
+   */
+  static const quantities::size_type parallel_block_size = 1 << 18;
+
+  /**
+   * Sums magnitudes sequentially, compensating for the rounding errors with
+   * Neumaier's variant of Kahan summation.
+   */
+  static double
+  compensated_sum(const double* magnitudes, quantities::size_type count)
+  {
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    for (quantities::size_type i = 0; i < count; ++i)
+    {
+      const auto magnitude = magnitudes[i];
+      const auto t = sum + magnitude;
+
+      if (std::fabs(sum) >= std::fabs(magnitude))
+      {
+        compensation += (sum - t) + magnitude;
+      } else {
+        compensation += (magnitude - t) + sum;
+      }
+      sum = t;
+    }
+
+    return sum + compensation;
+  }
+
+  /**
+   * Sums magnitudes by recursively splitting them into halves. The halves of
+   * large sums are computed in separate threads, as long as given number of
+   * threads allows it. The split points do not depend on the number of
+   * threads, so the result is the same regardless of it.
+   */
+  static double
+  pairwise_sum(
+    const double* magnitudes,
+    quantities::size_type count,
+    unsigned int threads
+  )
+  {
+    quantities::size_type half;
+
+    if (count <= pairwise_block_size)
+    {
+      return compensated_sum(magnitudes, count);
+    }
+    half = count / 2;
+    if (threads > 1 && count >= parallel_block_size)
+    {
+      std::future<double> left;
+
+      try
+      {
+        left = std::async(
+          std::launch::async,
+          pairwise_sum,
+          magnitudes,
+          half,
+          threads / 2
+        );
+      }
+      catch (const std::system_error&)
+      {
+        // Thread could not be started, so continue in this one.
+        threads = 1;
+      }
+      if (left.valid())
+      {
+        const auto right = pairwise_sum(
+          magnitudes + half,
+          count - half,
+          threads - threads / 2
+        );
+
+        return left.get() + right;
+      }
+    }
+
+    return pairwise_sum(magnitudes, half, threads)
+      + pairwise_sum(magnitudes + half, count - half, threads);
+  }
+
+  double
+  quantities::sum() const
+  {
+    return pairwise_sum(
+      magnitudes.data(),
+      magnitudes.size(),
+      std::max(std::thread::hardware_concurrency(), 1U)
+    );
+  }
+}
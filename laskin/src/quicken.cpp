@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <vector>
+
+#include "laskin/builtins.hpp"
+#include "laskin/context.hpp"
+#include "laskin/error.hpp"
+#include "laskin/quicken.hpp"
+
+namespace laskin::quicken
+{
+  struct specialization
+  {
+    /** The builtin word being specialized. */
+    quote::native word;
+    /** Type of the second topmost value of the stack. */
+    enum value::type a;
+    /** Type of the topmost value of the stack. */
+    enum value::type b;
+    /** Specialized implementation of the word. */
+    handler function;
+    /** The same operation performed directly on values. */
+    operation apply;
+  };
+
+  /**
+   * Replaces the two topmost values of the stack with result of given
+   * operation, if they are of the expected types. If the operation fails, the
+   * operands are removed from the stack before the error is propagated, just
+   * like the generic implementations of the words do.
+   */
+  template<enum value::type A, enum value::type B>
+  static inline bool
+  binary(class context& context, operation operation)
+  {
+    auto& data = context.data;
+    const auto size = data.size();
+
+    if (size < 2 || !data[size - 2].is(A) || !data[size - 1].is(B))
+    {
+      return false;
+    }
+    try
+    {
+      value result = context.numeric.coerce(
+        operation(data[size - 2], data[size - 1])
+      );
+
+      data.pop_back();
+      data.back() = std::move(result);
+    }
+    catch (const number::unit_error& e)
+    {
+      data.resize(size - 2);
+
+      throw error(error::type::unit, e.what());
+    }
+    catch (...)
+    {
+      data.resize(size - 2);
+
+      throw;
+    }
+
+    return true;
+  }
+
+#define LASKIN_QUICKEN(name, A, B, expression) \
+  static value name##_apply(const value& a, const value& b) \
+  { \
+    return expression; \
+  } \
+  static bool name(class context& context) \
+  { \
+    return binary<value::type::A, value::type::B>(context, name##_apply); \
+  }
+
+#define LASKIN_QUICKEN_COMPARE(name, T, op) \
+  LASKIN_QUICKEN(name, T, T, a.as_##T().compare(b.as_##T()) op 0)
+
+  // Numeric operations go through the value, so that integers stay as
+  // machine integers and real values as doubles whenever possible.
+  LASKIN_QUICKEN(add_number, number, number, a + b)
+  LASKIN_QUICKEN(sub_number, number, number, a - b)
+  LASKIN_QUICKEN(mul_number, number, number, a * b)
+  LASKIN_QUICKEN(div_number, number, number, a / b)
+  LASKIN_QUICKEN(mod_number, number, number, a % b)
+  LASKIN_QUICKEN(eq_number, number, number, a == b)
+  LASKIN_QUICKEN(ne_number, number, number, a != b)
+  LASKIN_QUICKEN(lt_number, number, number, a.compare(b) < 0)
+  LASKIN_QUICKEN(gt_number, number, number, a.compare(b) > 0)
+  LASKIN_QUICKEN(lte_number, number, number, a.compare(b) <= 0)
+  LASKIN_QUICKEN(gte_number, number, number, a.compare(b) >= 0)
+
+  LASKIN_QUICKEN(add_string, string, string, a.as_string() + b.as_string())
+  LASKIN_QUICKEN(eq_string, string, string, a.as_string() == b.as_string())
+  LASKIN_QUICKEN(ne_string, string, string, a.as_string() != b.as_string())
+  LASKIN_QUICKEN_COMPARE(lt_string, string, <)
+  LASKIN_QUICKEN_COMPARE(gt_string, string, >)
+  LASKIN_QUICKEN_COMPARE(lte_string, string, <=)
+  LASKIN_QUICKEN_COMPARE(gte_string, string, >=)
+
+  LASKIN_QUICKEN(add_vector, vector, number, a.as_vector() + b)
+  LASKIN_QUICKEN(sub_vector, vector, number, a.as_vector() - b)
+  LASKIN_QUICKEN(mul_vector, vector, number, a.as_vector() * b)
+  LASKIN_QUICKEN(div_vector, vector, number, a.as_vector() / b)
+  LASKIN_QUICKEN(mod_vector, vector, number, a.as_vector() % b)
+
+#undef LASKIN_QUICKEN_COMPARE
+#undef LASKIN_QUICKEN
+
+#define LASKIN_SPECIALIZATION(id, A, B, name) \
+  { id, value::type::A, value::type::B, name, name##_apply }
+
+  static std::vector<specialization>
+  build_specializations()
+  {
+    static const struct
+    {
+      std::u32string_view id;
+      enum value::type a;
+      enum value::type b;
+      handler function;
+      operation apply;
+    } catalogue[] =
+    {
+      LASKIN_SPECIALIZATION(U"+", number, number, add_number),
+      LASKIN_SPECIALIZATION(U"-", number, number, sub_number),
+      LASKIN_SPECIALIZATION(U"*", number, number, mul_number),
+      LASKIN_SPECIALIZATION(U"/", number, number, div_number),
+      LASKIN_SPECIALIZATION(U"%", number, number, mod_number),
+      LASKIN_SPECIALIZATION(U"=", number, number, eq_number),
+      LASKIN_SPECIALIZATION(U"<>", number, number, ne_number),
+      LASKIN_SPECIALIZATION(U"<", number, number, lt_number),
+      LASKIN_SPECIALIZATION(U">", number, number, gt_number),
+      LASKIN_SPECIALIZATION(U"<=", number, number, lte_number),
+      LASKIN_SPECIALIZATION(U">=", number, number, gte_number),
+
+      LASKIN_SPECIALIZATION(U"+", string, string, add_string),
+      LASKIN_SPECIALIZATION(U"=", string, string, eq_string),
+      LASKIN_SPECIALIZATION(U"<>", string, string, ne_string),
+      LASKIN_SPECIALIZATION(U"<", string, string, lt_string),
+      LASKIN_SPECIALIZATION(U">", string, string, gt_string),
+      LASKIN_SPECIALIZATION(U"<=", string, string, lte_string),
+      LASKIN_SPECIALIZATION(U">=", string, string, gte_string),
+
+      LASKIN_SPECIALIZATION(U"+", vector, number, add_vector),
+      LASKIN_SPECIALIZATION(U"-", vector, number, sub_vector),
+      LASKIN_SPECIALIZATION(U"*", vector, number, mul_vector),
+      LASKIN_SPECIALIZATION(U"/", vector, number, div_vector),
+      LASKIN_SPECIALIZATION(U"%", vector, number, mod_vector),
+    };
+
+#undef LASKIN_SPECIALIZATION
+
+    std::vector<specialization> result;
+
+    for (const auto& entry : catalogue)
+    {
+      // Specializations are keyed by the function that implements the word,
+      // so that they follow the builtin even when it's bound to another name.
+      if (const auto word = builtins::find(entry.id))
+      {
+        result.push_back({
+          word,
+          entry.a,
+          entry.b,
+          entry.function,
+          entry.apply
+        });
+      }
+    }
+
+    return result;
+  }
+
+  static const std::vector<specialization>&
+  specializations()
+  {
+    static const auto result = build_specializations();
+
+    return result;
+  }
+
+  handler
+  find(quote::native word, const class context& context)
+  {
+    const auto& data = context.data;
+    const auto size = data.size();
+
+    if (size < 2)
+    {
+      return nullptr;
+    }
+
+    const auto a = data[size - 2].type();
+    const auto b = data[size - 1].type();
+
+    for (const auto& entry : specializations())
+    {
+      if (entry.word == word && entry.a == a && entry.b == b)
+      {
+        return entry.function;
+      }
+    }
+
+    return nullptr;
+  }
+
+  std::optional<kernel>
+  kernel::match(
+    const class quote& quote,
+    const class context& context,
+    const class value& top
+  )
+  {
+    std::optional<class value> operand;
+    const value* word;
+
+    if (quote.is_native() || quote.is_scoped())
+    {
+      return std::nullopt;
+    }
+
+    const auto& nodes = quote.nodes();
+    const auto size = nodes.size();
+
+    if (size < 1 || size > 2 || !nodes[size - 1])
+    {
+      return std::nullopt;
+    }
+    else if (size == 2)
+    {
+      if (!nodes[0])
+      {
+        return std::nullopt;
+      }
+      else if (nodes[0]->type() == node::type::literal)
+      {
+        operand = std::static_pointer_cast<node::literal>(nodes[0])->value;
+      }
+      else if (nodes[0]->type() == node::type::symbol)
+      {
+        const auto& literal = std::static_pointer_cast<node::symbol>(
+          nodes[0]
+        )->id;
+        class value result;
+
+        // Number literals are parsed as symbols, which evaluate to the number
+        // unless an word with the same name has been defined.
+        if (
+          context.is_defined(literal) ||
+          !value::parse_number(literal, result)
+        )
+        {
+          return std::nullopt;
+        }
+        operand = context.numeric.coerce(std::move(result));
+      } else {
+        return std::nullopt;
+      }
+    }
+    if (nodes[size - 1]->type() != node::type::symbol)
+    {
+      return std::nullopt;
+    }
+
+    const auto& id = std::static_pointer_cast<node::symbol>(
+      nodes[size - 1]
+    )->id;
+    std::optional<enum value::type> binding_type;
+
+    // Just like with symbols, typed words are resolved by the type of the
+    // value that is on top of the stack when the word gets executed.
+    if (!(word = context.resolve(id)))
+    {
+      binding_type = operand ? operand->type() : top.type();
+      word = context.resolve(id, *binding_type);
+    }
+    if (!word || !word->is(value::type::quote))
+    {
+      return std::nullopt;
+    }
+    if (const auto target = word->as_quote().target())
+    {
+      return kernel(quote, target, operand, binding_type);
+    }
+
+    return std::nullopt;
+  }
+
+  class value
+  kernel::operator()(
+    class context& context,
+    std::ostream* out,
+    const class value& argument
+  ) const
+  {
+    if (m_operand)
+    {
+      if (m_binding_type && !m_operand->is(*m_binding_type))
+      {
+        return fallback(context, out, { &argument });
+      }
+      else if (const auto function = find(argument, *m_operand))
+      {
+        return apply(context, function, argument, *m_operand);
+      }
+    }
+    else if (m_binding_type && !argument.is(*m_binding_type))
+    {
+      return fallback(context, out, { &argument });
+    }
+
+    return call(context, out, { &argument });
+  }
+
+  class value
+  kernel::operator()(
+    class context& context,
+    std::ostream* out,
+    const class value& a,
+    const class value& b
+  ) const
+  {
+    const auto& top = m_operand ? *m_operand : b;
+
+    if (m_binding_type && !top.is(*m_binding_type))
+    {
+      return fallback(context, out, { &a, &b });
+    }
+    else if (!m_operand)
+    {
+      if (const auto function = find(a, b))
+      {
+        return apply(context, function, a, b);
+      }
+    }
+
+    return call(context, out, { &a, &b });
+  }
+
+  bool
+  kernel::is_binary() const
+  {
+    for (const auto& entry : specializations())
+    {
+      if (entry.word == m_word)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  operation
+  kernel::find(const class value& a, const class value& b) const
+  {
+    const auto type_a = a.type();
+    const auto type_b = b.type();
+
+    for (const auto& entry : specializations())
+    {
+      if (entry.word == m_word && entry.a == type_a && entry.b == type_b)
+      {
+        return entry.apply;
+      }
+    }
+
+    return nullptr;
+  }
+
+  class value
+  kernel::apply(
+    const class context& context,
+    operation function,
+    const class value& a,
+    const class value& b
+  )
+  {
+    try
+    {
+      // Coerced just like on the stack, so that the representation of the
+      // result does not depend on whether the kernel was used or not.
+      return context.numeric.coerce(function(a, b));
+    }
+    catch (const number::unit_error& e)
+    {
+      throw error(error::type::unit, e.what());
+    }
+  }
+
+  class value
+  kernel::call(
+    class context& context,
+    std::ostream* out,
+    std::initializer_list<const class value*> arguments
+  ) const
+  {
+    for (const auto argument : arguments)
+    {
+      context.data.push_back(*argument);
+    }
+    if (m_operand)
+    {
+      context.data.push_back(*m_operand);
+    }
+    m_word(context, out);
+
+    return context.pop();
+  }
+
+  class value
+  kernel::fallback(
+    class context& context,
+    std::ostream* out,
+    std::initializer_list<const class value*> arguments
+  ) const
+  {
+    for (const auto argument : arguments)
+    {
+      context.data.push_back(*argument);
+    }
+    m_quote.call(context, out);
+
+    return context.pop();
+  }
+}
@@ -23,18 +23,97 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include "laskin/context.hpp"
 #include "laskin/error.hpp"
+#include "laskin/optimizer.hpp"
+#include "laskin/profiler.hpp"
 #include "laskin/quote.hpp"
 
 namespace laskin
 {
-  quote::quote() {}
+  static bool
+  declares_locals(const quote::node_container& nodes)
+  {
+    for (const auto& node : nodes)
+    {
+      if (node && node->type() == node::type::binding)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  quote::quote()
+    : m_scoped(false) {}
 
   quote::quote(const callback& cb)
-    : m_container(cb) {}
+    : m_container(cb)
+    , m_scoped(false) {}
+
+  quote::quote(native fn)
+    : m_container(fn)
+    , m_scoped(false) {}
 
   quote::quote(const node_container& nodes)
-    : m_container(nodes) {}
+    : m_container(nodes)
+    , m_compiled(std::make_shared<std::optional<node_container>>())
+    , m_scoped(declares_locals(nodes)) {}
+
+  quote::quote(const std::shared_ptr<deferred>& source)
+    : m_container(node_container())
+    , m_compiled(std::make_shared<std::optional<node_container>>())
+    , m_scoped(false)
+    , m_deferred(source) {}
+
+  bool
+  quote::deferred::is_scoped()
+  {
+    if (!m_scoped)
+    {
+      m_scoped = declares_locals(nodes());
+    }
+
+    return *m_scoped;
+  }
+
+  const quote::node_container&
+  quote::body() const
+  {
+    return m_deferred
+      ? m_deferred->nodes()
+      : std::get<node_container>(m_container);
+  }
+
+  std::shared_ptr<const quote::node_container>
+  quote::compiled() const
+  {
+    static const auto empty = std::make_shared<const node_container>();
+
+    if (!m_compiled)
+    {
+      return empty;
+    }
+    else if (!*m_compiled)
+    {
+      *m_compiled = optimizer::optimize(body());
+    }
+
+    // Share ownership with the compilation state, so that the compiled nodes
+    // stay alive even if the quote itself gets destroyed while it's running.
+    return std::shared_ptr<const node_container>(m_compiled, &**m_compiled);
+  }
+
+  quote
+  quote::bind(const std::shared_ptr<class frame>& frame) const
+  {
+    quote result(*this);
+
+    result.m_frame = frame;
+
+    return result;
+  }
 
   void
   quote::call(
@@ -44,37 +123,107 @@ namespace laskin
   {
     if (std::holds_alternative<node_container>(m_container))
     {
-      for (const auto& node : std::get<node_container>(m_container))
+      if (is_scoped())
       {
-        if (node)
+        const auto caller = context.frame;
+
+        // Each call gets activation frame of it's own, created when the first
+        // local variable is bound, so that recursive calls do not clobber
+        // each other's variables.
+        context.frame = m_frame;
+        try
         {
-          try
-          {
-            node->exec(context, out);
-          }
-          catch (const error& e)
-          {
-            throw error(e.type, e.message, node->position);
-          }
+          execute(context, out);
+        }
+        catch (...)
+        {
+          context.frame = caller;
+          throw;
         }
+        context.frame = caller;
+      } else {
+        execute(context, out);
       }
     }
+    else if (std::holds_alternative<native>(m_container))
+    {
+      std::get<native>(m_container)(context, out);
+    }
     else if (std::holds_alternative<callback>(m_container))
     {
       std::get<callback>(m_container)(context, out);
     }
   }
 
+  void
+  quote::execute(
+    class context& context,
+    std::ostream* out
+  ) const
+  {
+    const auto nodes = context.profiler
+      ? std::make_shared<const node_container>(body())
+      : compiled();
+    const auto size = nodes->size();
+
+    for (node_container::size_type i = 0; i < size; ++i)
+    {
+      const auto& node = (*nodes)[i];
+
+      if (context.profiler)
+      {
+        context.profiler->record(*nodes, i);
+      }
+      if (node)
+      {
+        try
+        {
+          node->exec(context, out);
+        }
+        catch (const error& e)
+        {
+          // Nodes produced by the optimizer do not have position of their
+          // own, as they already report position of the original node.
+          throw error(
+            e.type,
+            e.message,
+            node->position ? node->position : e.position
+          );
+        }
+      }
+    }
+  }
+
   bool
   quote::equals(const quote& that) const
   {
     if (std::holds_alternative<node_container>(m_container))
     {
-      const auto& a = std::get<node_container>(m_container);
+      // Copies of the same quote share their compilation state, and thus also
+      // the nodes.
+      if (m_compiled == that.m_compiled)
+      {
+        return true;
+      }
+
+      // Quote literals with identical source code cannot differ, so there's
+      // no need to parse them for the comparison.
+      if (m_deferred && that.m_deferred)
+      {
+        if (
+          m_deferred == that.m_deferred ||
+          m_deferred->text() == that.m_deferred->text()
+        )
+        {
+          return true;
+        }
+      }
+
+      const auto& a = body();
 
       if (std::holds_alternative<node_container>(that.m_container))
       {
-        const auto& b = std::get<node_container>(that.m_container);
+        const auto& b = that.body();
         const auto size = a.size();
 
         if (b.size() != size)
@@ -91,13 +240,22 @@ namespace laskin
 
         return true;
       }
-      else if (!std::holds_alternative<callback>(that.m_container))
+      else if (
+        !std::holds_alternative<callback>(that.m_container) &&
+        !std::holds_alternative<native>(that.m_container)
+      )
       {
         return a.empty();
       }
 
       return false;
     }
+    else if (std::holds_alternative<native>(m_container))
+    {
+      // Function pointers can be compared with each other directly.
+      return std::holds_alternative<native>(that.m_container) &&
+        std::get<native>(m_container) == std::get<native>(that.m_container);
+    }
     else if (std::holds_alternative<callback>(m_container))
     {
       // It's almost impossible to test equality between two `std::function`
@@ -107,7 +265,8 @@ namespace laskin
       return false;
     } else {
       return !std::holds_alternative<node_container>(that.m_container) &&
-        !std::holds_alternative<callback>(that.m_container);
+        !std::holds_alternative<callback>(that.m_container) &&
+        !std::holds_alternative<native>(that.m_container);
     }
   }
 
@@ -120,7 +279,7 @@ namespace laskin
       bool first = true;
 
       result.append(1, U'(');
-      for (const auto& node : std::get<node_container>(m_container))
+      for (const auto& node : body())
       {
         if (first)
         {
@@ -137,7 +296,10 @@ namespace laskin
 
       return result;
     }
-    else if (std::holds_alternative<callback>(m_container))
+    else if (
+      std::holds_alternative<callback>(m_container) ||
+      std::holds_alternative<native>(m_container)
+    )
     {
       return U"(\"native quote\")";
     }
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "laskin/random.hpp"
+
+namespace laskin
+{
+  static inline std::uint64_t
+  rotl(std::uint64_t x, int k)
+  {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  /**
+   * SplitMix64 generator, used for expanding seed into the state of the
+   * actual generator.
+   */
+  static inline std::uint64_t
+  splitmix64(std::uint64_t& state)
+  {
+    auto z = (state += 0x9e3779b97f4a7c15);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+
+    return z ^ (z >> 31);
+  }
+
+  /**
+   * Advances xoshiro256** state by one step and returns the next 64 bits.
+   */
+  static inline std::uint64_t
+  xoshiro256(std::uint64_t (&state)[4])
+  {
+    const auto result = rotl(state[1] * 5, 7) * 9;
+    const auto t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+
+    return result;
+  }
+
+  /**
+   * Converts 64 random bits into an double from range [0, 1).
+   */
+  static inline double
+  to_unit_interval(std::uint64_t bits)
+  {
+    // Use the upper 53 bits, which is all that fits into an double.
+    return static_cast<double>(bits >> 11) * 0x1.0p-53;
+  }
+
+  random_generator::random_generator()
+    : m_state{ 0, 0, 0, 0 }
+    , m_seeded(false) {}
+
+  void
+  random_generator::seed(std::uint64_t seed)
+  {
+    for (auto& word : m_state)
+    {
+      word = splitmix64(seed);
+    }
+    m_seeded = true;
+  }
+
+  void
+  random_generator::ensure_seeded()
+  {
+    if (!m_seeded)
+    {
+      std::random_device device;
+
+      seed((static_cast<std::uint64_t>(device()) << 32) ^ device());
+    }
+  }
+
+  random_generator::result_type
+  random_generator::next()
+  {
+    ensure_seeded();
+
+    return xoshiro256(m_state);
+  }
+
+  double
+  random_generator::uniform()
+  {
+    return to_unit_interval(next());
+  }
+
+  void
+  random_generator::uniform(double* output, std::size_t count)
+  {
+    ensure_seeded();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      output[i] = to_unit_interval(xoshiro256(m_state));
+    }
+  }
+
+  long
+  random_generator::integer(long min, long max)
+  {
+    const auto range = static_cast<std::uint64_t>(max)
+      - static_cast<std::uint64_t>(min)
+      + 1;
+    std::uint64_t limit;
+    std::uint64_t result;
+
+    // The range covers every long integer.
+    if (!range)
+    {
+      return static_cast<long>(next());
+    }
+    // Reject values from the incomplete last block, so that every value in
+    // the range is equally likely.
+    limit = std::numeric_limits<std::uint64_t>::max()
+      - std::numeric_limits<std::uint64_t>::max() % range;
+    do
+    {
+      result = next();
+    }
+    while (result >= limit);
+
+    return static_cast<long>(static_cast<std::uint64_t>(min) + result % range);
+  }
+
+  double
+  random_generator::normal()
+  {
+    // Box-Muller transform. The first uniform is taken from range (0, 1], so
+    // that the logarithm stays finite.
+    const auto u1 = 1.0 - uniform();
+    const auto u2 = uniform();
+
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+  }
+
+  void
+  random_generator::jump()
+  {
+    static const std::uint64_t polynomial[] =
+    {
+      0x180ec6d33cfd0aba,
+      0xd5a61266f0c9392c,
+      0xa9582618e03fc9aa,
+      0x39abdc4529b1661c,
+    };
+    std::uint64_t state[4] = { 0, 0, 0, 0 };
+
+    ensure_seeded();
+    for (const auto word : polynomial)
+    {
+      for (int bit = 0; bit < 64; ++bit)
+      {
+        if (word & (static_cast<std::uint64_t>(1) << bit))
+        {
+          state[0] ^= m_state[0];
+          state[1] ^= m_state[1];
+          state[2] ^= m_state[2];
+          state[3] ^= m_state[3];
+        }
+        next();
+      }
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+      m_state[i] = state[i];
+    }
+  }
+}
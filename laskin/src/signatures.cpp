@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <unordered_map>
+
+#include "laskin/builtins.hpp"
+
+namespace laskin::builtins
+{
+  /**
+   * Stack effects of the builtin words, in the same notation as used in the
+   * documentation of the words.
+   */
+  static const std::pair<std::u32string_view, std::u32string_view>
+  signatures[] =
+  {
+    // Utility words.
+    { U"=", U"( any any -- boolean )" },
+    { U"<>", U"( any any -- boolean )" },
+    { U">", U"( any any -- boolean )" },
+    { U"<", U"( any any -- boolean )" },
+    { U">=", U"( any any -- boolean )" },
+    { U"<=", U"( any any -- boolean )" },
+    { U"+", U"( any any -- any )" },
+    { U"-", U"( any any -- any )" },
+    { U"*", U"( any any -- any )" },
+    { U"/", U"( any any -- any )" },
+    { U"%", U"( any any -- any )" },
+    { U"boolean?", U"( any -- any boolean )" },
+    { U"date?", U"( any -- any boolean )" },
+    { U"month?", U"( any -- any boolean )" },
+    { U"number?", U"( any -- any boolean )" },
+    { U"vector?", U"( any -- any boolean )" },
+    { U"record?", U"( any -- any boolean )" },
+    { U"string?", U"( any -- any boolean )" },
+    { U"time?", U"( any -- any boolean )" },
+    { U"quote?", U"( any -- any boolean )" },
+    { U"weekday?", U"( any -- any boolean )" },
+    { U"clear", U"( any... -- )" },
+    { U"dup", U"( a -- a a )" },
+    { U"drop", U"( any -- )" },
+    { U"nip", U"( a b -- b )" },
+    { U"over", U"( a b -- a b a )" },
+    { U"rot", U"( a b c -- b c a )" },
+    { U"swap", U"( a b -- b a )" },
+    { U"tuck", U"( a b -- b a b )" },
+    { U"depth", U"( -- number )" },
+    { U">string", U"( any -- string )" },
+    { U">source", U"( any -- string )" },
+    { U".", U"( any -- )" },
+    { U"..", U"( any -- )" },
+    { U".s", U"( -- )" },
+    { U"quit", U"( -- )" },
+    { U"if", U"( boolean quote -- )" },
+    { U"if-else", U"( boolean quote quote -- )" },
+    { U"while", U"( quote quote -- )" },
+    { U"try", U"( quote quote -- )" },
+    { U"try-else", U"( quote quote quote -- )" },
+    { U"lookup", U"( string -- quote )" },
+    { U"define", U"( quote string -- )" },
+    { U"delete", U"( string -- )" },
+    { U"symbols", U"( -- vector )" },
+    { U"include", U"( string -- )" },
+
+    // Boolean words.
+    { U"true", U"( -- boolean )" },
+    { U"false", U"( -- boolean )" },
+    { U"boolean:not", U"( boolean -- boolean )" },
+    { U"boolean:and", U"( boolean boolean -- boolean )" },
+    { U"boolean:or", U"( boolean boolean -- boolean )" },
+    { U"boolean:xor", U"( boolean boolean -- boolean )" },
+
+    // Date words.
+    { U"today", U"( -- date )" },
+    { U"tomorrow", U"( -- date )" },
+    { U"yesterday", U"( -- date )" },
+    { U"date:year", U"( date -- date number )" },
+    { U"date:month", U"( date -- date month )" },
+    { U"date:day", U"( date -- date number )" },
+    { U"date:weekday", U"( date -- date weekday )" },
+    { U"date:day-of-year", U"( date -- date number )" },
+    { U"date:days-in-month", U"( date -- date number )" },
+    { U"date:days-in-year", U"( date -- date number )" },
+    { U"date:leap-year?", U"( date -- date boolean )" },
+    { U"date:format", U"( string date -- string )" },
+    { U"date:>number", U"( date -- number )" },
+    { U"date:>vector", U"( date -- vector )" },
+
+    // Month words.
+    { U"january", U"( -- month )" },
+    { U"february", U"( -- month )" },
+    { U"march", U"( -- month )" },
+    { U"april", U"( -- month )" },
+    { U"may", U"( -- month )" },
+    { U"june", U"( -- month )" },
+    { U"july", U"( -- month )" },
+    { U"august", U"( -- month )" },
+    { U"september", U"( -- month )" },
+    { U"october", U"( -- month )" },
+    { U"november", U"( -- month )" },
+    { U"december", U"( -- month )" },
+    { U"month:>number", U"( month -- number )" },
+
+    // Numeric words.
+    { U"pi", U"( -- number )" },
+    { U"e", U"( -- number )" },
+    { U"inf", U"( -- number )" },
+    { U"-inf", U"( -- number )" },
+    { U"nan", U"( -- number )" },
+    { U"number:has-unit?", U"( number -- number boolean )" },
+    { U"number:unit", U"( number -- number string )" },
+    { U"number:unit-type", U"( number -- number string )" },
+    { U"number:drop-unit", U"( number -- number )" },
+    { U"number:inf?", U"( number -- number boolean )" },
+    { U"number:nan?", U"( number -- number boolean )" },
+    { U"number:range", U"( number number -- vector )" },
+    { U"number:clamp", U"( number number number -- number )" },
+    { U"number:times", U"( quote number -- )" },
+    { U"number:precision", U"( number -- )" },
+    { U"number:ceil", U"( number -- number )" },
+    { U"number:floor", U"( number -- number )" },
+    { U"number:round", U"( number -- number )" },
+    { U"number:exp", U"( number -- number )" },
+    { U"number:exp2", U"( number -- number )" },
+    { U"number:expm1", U"( number -- number )" },
+    { U"number:log", U"( number -- number )" },
+    { U"number:log10", U"( number -- number )" },
+    { U"number:log2", U"( number -- number )" },
+    { U"number:log1p", U"( number -- number )" },
+    { U"number:pow", U"( number number -- number )" },
+    { U"number:sqrt", U"( number -- number )" },
+    { U"number:cbrt", U"( number -- number )" },
+    { U"number:hypot", U"( number number -- number )" },
+    { U"number:acos", U"( number -- number )" },
+    { U"number:asin", U"( number -- number )" },
+    { U"number:atan", U"( number -- number )" },
+    { U"number:atan2", U"( number number -- number )" },
+    { U"number:cos", U"( number -- number )" },
+    { U"number:sin", U"( number -- number )" },
+    { U"number:tan", U"( number -- number )" },
+    { U"number:deg", U"( number -- number )" },
+    { U"number:rad", U"( number -- number )" },
+    { U"number:sinh", U"( number -- number )" },
+    { U"number:cosh", U"( number -- number )" },
+    { U"number:tanh", U"( number -- number )" },
+    { U"number:asinh", U"( number -- number )" },
+    { U"number:acosh", U"( number -- number )" },
+    { U"number:atanh", U"( number -- number )" },
+    { U"number:>month", U"( number -- month )" },
+    { U"number:>weekday", U"( number -- weekday )" },
+
+    // Numeric words broadcast over vectors.
+    { U"vector:clamp", U"( number number vector -- vector )" },
+    { U"vector:ceil", U"( vector -- vector )" },
+    { U"vector:floor", U"( vector -- vector )" },
+    { U"vector:round", U"( vector -- vector )" },
+    { U"vector:exp", U"( vector -- vector )" },
+    { U"vector:exp2", U"( vector -- vector )" },
+    { U"vector:expm1", U"( vector -- vector )" },
+    { U"vector:log", U"( vector -- vector )" },
+    { U"vector:log10", U"( vector -- vector )" },
+    { U"vector:log2", U"( vector -- vector )" },
+    { U"vector:log1p", U"( vector -- vector )" },
+    { U"vector:pow", U"( number vector -- vector )" },
+    { U"vector:sqrt", U"( vector -- vector )" },
+    { U"vector:cbrt", U"( vector -- vector )" },
+    { U"vector:hypot", U"( number vector -- vector )" },
+    { U"vector:acos", U"( vector -- vector )" },
+    { U"vector:asin", U"( vector -- vector )" },
+    { U"vector:atan", U"( vector -- vector )" },
+    { U"vector:atan2", U"( number vector -- vector )" },
+    { U"vector:cos", U"( vector -- vector )" },
+    { U"vector:sin", U"( vector -- vector )" },
+    { U"vector:tan", U"( vector -- vector )" },
+    { U"vector:deg", U"( vector -- vector )" },
+    { U"vector:rad", U"( vector -- vector )" },
+    { U"vector:sinh", U"( vector -- vector )" },
+    { U"vector:cosh", U"( vector -- vector )" },
+    { U"vector:tanh", U"( vector -- vector )" },
+    { U"vector:asinh", U"( vector -- vector )" },
+    { U"vector:acosh", U"( vector -- vector )" },
+    { U"vector:atanh", U"( vector -- vector )" },
+
+    // Quote words.
+    { U"quote:call", U"( quote -- )" },
+    { U"quote:compose", U"( quote quote -- quote )" },
+    { U"quote:curry", U"( any quote -- quote )" },
+    { U"quote:negate", U"( quote -- quote )" },
+    { U"quote:dip", U"( any quote -- any )" },
+    { U"quote:effect", U"( quote -- boolean|string )" },
+
+    // Random words.
+    { U"random:seed", U"( number -- )" },
+    { U"random:jump", U"( -- )" },
+    { U"random:number", U"( -- number )" },
+    { U"random:integer", U"( number number -- number )" },
+    { U"random:normal", U"( number number -- number )" },
+    { U"random:vector", U"( number -- vector )" },
+    { U"random:shuffle", U"( vector -- vector )" },
+    { U"random:sample", U"( number vector -- vector )" },
+
+    // Record words.
+    { U"record:size", U"( record -- record number )" },
+    { U"record:keys", U"( record -- record vector )" },
+    { U"record:values", U"( record -- record vector )" },
+    { U"record:for-each", U"( quote record -- )" },
+    { U"record:map", U"( quote record -- record )" },
+    { U"record:filter", U"( quote record -- record )" },
+    { U"record:@", U"( string record -- any )" },
+    { U"record:@=", U"( any string record -- record )" },
+    { U"record:>vector", U"( record -- vector )" },
+
+    // String words.
+    { U"string:length", U"( string -- string number )" },
+    { U"string:chars", U"( string -- string vector )" },
+    { U"string:runes", U"( string -- string vector )" },
+    { U"string:words", U"( string -- string vector )" },
+    { U"string:lines", U"( string -- string vector )" },
+    { U"string:starts-with?", U"( string string -- boolean )" },
+    { U"string:ends-with?", U"( string string -- boolean )" },
+    { U"string:includes?", U"( string string -- boolean )" },
+    { U"string:index-of", U"( string string -- boolean|number )" },
+    { U"string:last-index-of", U"( string string -- boolean|number )" },
+    { U"string:reverse", U"( string -- string )" },
+    { U"string:lower-case", U"( string -- string )" },
+    { U"string:upper-case", U"( string -- string )" },
+    { U"string:swap-case", U"( string -- string )" },
+    { U"string:trim", U"( string -- string )" },
+    { U"string:trim-start", U"( string -- string )" },
+    { U"string:trim-end", U"( string -- string )" },
+    { U"string:substring", U"( number number string -- string )" },
+    { U"string:split", U"( string string -- vector )" },
+    { U"string:repeat", U"( number string -- string )" },
+    { U"string:replace", U"( string string string -- string )" },
+    { U"string:pad-start", U"( number string string -- string )" },
+    { U"string:pad-end", U"( number string string -- string )" },
+    { U"string:@", U"( number string -- string )" },
+    { U"string:>number", U"( string -- number )" },
+    { U"string:>quote", U"( string -- quote )" },
+
+    // Time words.
+    { U"now", U"( -- time )" },
+    { U"time:hour", U"( time -- time number )" },
+    { U"time:minute", U"( time -- time number )" },
+    { U"time:second", U"( time -- time number )" },
+    { U"time:format", U"( string time -- string )" },
+    { U"time:>number", U"( time -- number )" },
+    { U"time:>vector", U"( time -- vector )" },
+
+    // Vector words.
+    { U"vector", U"( any... number -- vector )" },
+    { U"vector:length", U"( vector -- vector number )" },
+    { U"vector:max", U"( vector -- any )" },
+    { U"vector:min", U"( vector -- any )" },
+    { U"vector:mean", U"( vector -- any )" },
+    { U"vector:sum", U"( vector -- any )" },
+    { U"vector:median", U"( vector -- any )" },
+    { U"vector:percentile", U"( number vector -- any )" },
+    { U"vector:variance", U"( vector -- number )" },
+    { U"vector:stddev", U"( vector -- number )" },
+    { U"vector:histogram", U"( number vector -- vector )" },
+    { U"vector:describe", U"( vector -- record )" },
+    { U"vector:for-each", U"( quote vector -- )" },
+    { U"vector:map", U"( quote vector -- vector )" },
+    { U"vector:filter", U"( quote vector -- vector )" },
+    { U"vector:reduce", U"( quote vector -- any )" },
+    { U"vector:prepend", U"( any vector -- vector )" },
+    { U"vector:append", U"( any vector -- vector )" },
+    { U"vector:insert", U"( any number vector -- vector )" },
+    { U"vector:reverse", U"( vector -- vector )" },
+    { U"vector:extract", U"( vector -- any... )" },
+    { U"vector:sort", U"( vector -- vector )" },
+    { U"vector:@", U"( number vector -- any )" },
+    { U"vector:@=", U"( any number vector -- vector )" },
+    { U"vector:>date", U"( vector -- date )" },
+    { U"vector:>time", U"( vector -- time )" },
+
+    // Weekday words.
+    { U"sunday", U"( -- weekday )" },
+    { U"monday", U"( -- weekday )" },
+    { U"tuesday", U"( -- weekday )" },
+    { U"wednesday", U"( -- weekday )" },
+    { U"thursday", U"( -- weekday )" },
+    { U"friday", U"( -- weekday )" },
+    { U"saturday", U"( -- weekday )" },
+    { U"weekday:weekend?", U"( weekday -- weekday boolean )" },
+    { U"weekday:>number", U"( weekday -- number )" },
+  };
+
+  std::optional<std::u32string_view>
+  signature(std::u32string_view id)
+  {
+    static const std::unordered_map<
+      std::u32string_view,
+      std::u32string_view
+    > table(std::begin(signatures), std::end(signatures));
+    const auto entry = table.find(id);
+
+    if (entry != std::end(table))
+    {
+      return entry->second;
+    }
+
+    return std::nullopt;
+  }
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <peelo/chrono/duration.hpp>
+#include <peelo/unicode/encoding/utf8.hpp>
+
+#include "laskin/units.hpp"
+
+namespace laskin::units
+{
+  struct entry
+  {
+    /** The measurement unit, or nothing for numbers without one. */
+    std::optional<number::unit> unit;
+    /** Number of seconds in one of the unit, if it's an time unit. */
+    long seconds;
+  };
+
+  /**
+   * Process wide registry of measurement units. Entries are kept in an deque
+   * so that pointers to them remain valid when more units are registered.
+   * Units are registered rarely compared to how often they are looked up,
+   * so lookups only need shared lock.
+   */
+  struct registry
+  {
+    std::shared_mutex mutex;
+    /** Registered units, indexed by their identifiers. */
+    std::deque<entry> entries;
+    /** Mapping of unit symbols, and aliases of them, into identifiers. */
+    std::unordered_map<std::string, id> ids;
+    /**
+     * Conversions between pairs of units, keyed by both of their
+     * identifiers. Pairs of units that cannot be converted are remembered as
+     * well.
+     */
+    std::unordered_map<std::uint32_t, std::optional<conversion>> conversions;
+
+    explicit registry();
+
+    id intern(const number::unit& unit);
+  };
+
+  /**
+   * Resolves measurement unit with given symbol through the arbitrary
+   * precision number parser.
+   */
+  static std::optional<number::unit>
+  resolve(const std::u32string& symbol)
+  {
+    const auto input = U"1" + symbol;
+
+    if (!number::is_valid(input))
+    {
+      return std::nullopt;
+    }
+
+    return number::parse(input).measurement_unit();
+  }
+
+  registry::registry()
+  {
+    using peelo::chrono::duration;
+
+    static const struct
+    {
+      const char32_t* symbol;
+      long seconds;
+    } time_units[] =
+    {
+      { U"s", 1 },
+      { U"min", duration::seconds_per_hour / duration::minutes_per_hour },
+      { U"h", duration::seconds_per_hour },
+      { U"d", duration::seconds_per_day },
+    };
+
+    entries.push_back({ std::nullopt, 0 });
+    for (const auto& time_unit : time_units)
+    {
+      const auto unit = resolve(time_unit.symbol);
+
+      entries.push_back({ unit, time_unit.seconds });
+      if (unit)
+      {
+        ids[unit->symbol] = static_cast<id>(entries.size() - 1);
+      }
+    }
+  }
+
+  /**
+   * Registers given unit, unless it has been registered already. Caller has
+   * to hold exclusive lock of the registry.
+   */
+  id
+  registry::intern(const number::unit& unit)
+  {
+    const auto existing = ids.find(unit.symbol);
+
+    if (existing != std::end(ids))
+    {
+      return existing->second;
+    }
+    entries.push_back({ unit, 0 });
+
+    return ids[unit.symbol] = static_cast<id>(entries.size() - 1);
+  }
+
+  static registry&
+  instance()
+  {
+    static class registry registry;
+
+    return registry;
+  }
+
+  /**
+   * Looks up identifier of given unit symbol, or alias of one, without
+   * registering anything.
+   */
+  static std::optional<id>
+  lookup(class registry& registry, const std::string& symbol)
+  {
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+    const auto existing = registry.ids.find(symbol);
+
+    if (existing != std::end(registry.ids))
+    {
+      return existing->second;
+    }
+
+    return std::nullopt;
+  }
+
+  id
+  find(const std::u32string& symbol)
+  {
+    using peelo::unicode::encoding::utf8::encode;
+
+    auto& registry = instance();
+    const auto key = encode(symbol);
+
+    if (const auto existing = lookup(registry, key))
+    {
+      return *existing;
+    }
+
+    const auto unit = resolve(symbol);
+
+    // Symbols that are not units are not remembered, as they could be
+    // anything, such as remainders of date literals, and the registry would
+    // keep growing with them.
+    if (!unit)
+    {
+      return none;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+    const auto result = registry.intern(*unit);
+
+    // Remember also aliases that resolve into units with different symbol.
+    registry.ids[key] = result;
+
+    return result;
+  }
+
+  id
+  of(const number& number)
+  {
+    const auto& unit = number.measurement_unit();
+
+    if (!unit)
+    {
+      return none;
+    }
+
+    auto& registry = instance();
+
+    if (const auto existing = lookup(registry, unit->symbol))
+    {
+      return *existing;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+
+    return registry.intern(*unit);
+  }
+
+  const number::unit*
+  get(id unit)
+  {
+    auto& registry = instance();
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+
+    if (unit >= registry.entries.size() || !registry.entries[unit].unit)
+    {
+      return nullptr;
+    }
+
+    return &*registry.entries[unit].unit;
+  }
+
+  long
+  seconds(id unit)
+  {
+    auto& registry = instance();
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+
+    return unit < registry.entries.size() ? registry.entries[unit].seconds : 0;
+  }
+
+  std::optional<dimension_type>
+  dimension(id unit)
+  {
+    if (const auto measurement_unit = get(unit))
+    {
+      return measurement_unit->type;
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * Computes conversion between two units with the arbitrary precision
+   * arithmetic. The common unit is the one that adding numbers with the two
+   * units together results in, and the multipliers are ratios of one of each
+   * unit to one of the common unit. Caller has to hold exclusive lock of the
+   * registry.
+   */
+  static std::optional<conversion>
+  compute(class registry& registry, id first, id second)
+  {
+    const auto& a = registry.entries[first].unit;
+    const auto& b = registry.entries[second].unit;
+
+    if (!a || !b || a->type != b->type)
+    {
+      return std::nullopt;
+    }
+    try
+    {
+      const auto sum = number(0.0, *a) + number(0.0, *b);
+      const auto& common = sum.measurement_unit();
+
+      if (!common)
+      {
+        return std::nullopt;
+      }
+
+      const number one(1.0, *common);
+
+      return conversion
+      {
+        registry.intern(*common),
+        double(number(1.0, *a) / one),
+        double(number(1.0, *b) / one),
+      };
+    }
+    catch (const std::exception&)
+    {
+      return std::nullopt;
+    }
+  }
+
+  std::optional<conversion>
+  convert(id first, id second)
+  {
+    auto& registry = instance();
+    const auto key = (static_cast<std::uint32_t>(first) << 16) | second;
+
+    {
+      std::shared_lock<std::shared_mutex> lock(registry.mutex);
+      const auto existing = registry.conversions.find(key);
+
+      if (existing != std::end(registry.conversions))
+      {
+        return existing->second;
+      }
+      else if (
+        first >= registry.entries.size() ||
+        second >= registry.entries.size()
+      )
+      {
+        return std::nullopt;
+      }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+
+    return registry.conversions[key] = compute(registry, first, second);
+  }
+}
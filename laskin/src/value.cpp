@@ -28,8 +28,11 @@
 
 #include <peelo/unicode/encoding/utf8.hpp>
 
+#include "laskin/big_integer.hpp"
 #include "laskin/chrono.hpp"
+#include "laskin/decimal.hpp"
 #include "laskin/error.hpp"
+#include "laskin/format.hpp"
 #include "laskin/quote.hpp"
 #include "laskin/utils.hpp"
 
@@ -38,14 +41,62 @@ namespace laskin
   value
   value::parse_number(const std::u32string& input)
   {
-    try
+    value result;
+
+    if (!parse_number(input, result))
     {
-      return number::parse(input);
+      throw error(error::type::range, U"Input does not contain valid number.");
     }
-    catch (const std::invalid_argument&)
+
+    return result;
+  }
+
+  bool
+  value::parse_number(const std::u32string& input, value& result)
+  {
+    using peelo::unicode::encoding::utf8::encode;
+
+    switch (decimal::parse(input, result))
     {
-      throw error(error::type::range, U"Input does not contain valid number.");
+      case decimal::errc::ok:
+        return true;
+
+      case decimal::errc::invalid:
+        return false;
+
+      // Leave numbers that need more precision than double has, as well as
+      // measurement units that are not known yet, for the arbitrary
+      // precision parser.
+      case decimal::errc::out_of_range:
+      case decimal::errc::unknown_unit:
+        break;
+    }
+    // Integers that do not fit into long are stored exactly as big integers.
+    if (big_integer integer; big_integer::parse(encode(input), integer))
+    {
+      result = integer;
+
+      return true;
+    }
+    if (!number::is_valid(input))
+    {
+      return false;
     }
+    result = number::parse(input);
+
+    return true;
+  }
+
+  value
+  value::real(double value)
+  {
+    class value result;
+
+    result.m_type = type::number;
+    result.m_real = true;
+    result.m_value_real = value;
+
+    return result;
   }
 
   value::value()
@@ -62,16 +113,30 @@ namespace laskin
 
   value::value(int value)
     : m_type(type::number)
-    , m_value_number(new number(value)) {}
+    , m_integer(true)
+    , m_value_integer(value) {}
 
   value::value(long value)
     : m_type(type::number)
-    , m_value_number(new number(value)) {}
+    , m_integer(true)
+    , m_value_integer(value) {}
 
   value::value(double value)
     : m_type(type::number)
     , m_value_number(new number(value)) {}
 
+  value::value(const big_integer& value)
+    : m_type(type::number)
+  {
+    if ((m_integer = value.fits_long()))
+    {
+      m_value_integer = value.to_long();
+    } else {
+      m_big_integer = true;
+      m_value_big_integer = new big_integer(value);
+    }
+  }
+
   value::value(const std::u32string& value)
     : m_type(type::string)
     , m_value_string(new std::u32string(value)) {}
@@ -120,7 +185,21 @@ namespace laskin
         break;
 
       case type::number:
-        m_value_number = new number(*that.m_value_number);
+        m_unit_id = that.m_unit_id;
+        if ((m_integer = that.m_integer))
+        {
+          m_value_integer = that.m_value_integer;
+        }
+        else if ((m_real = that.m_real))
+        {
+          m_value_real = that.m_value_real;
+        }
+        else if ((m_big_integer = that.m_big_integer))
+        {
+          m_value_big_integer = new big_integer(*that.m_value_big_integer);
+        } else {
+          m_value_number = new number(*that.m_value_number);
+        }
         break;
 
       case type::vector:
@@ -167,7 +246,23 @@ namespace laskin
         break;
 
       case type::number:
-        m_value_number = that.m_value_number;
+        m_unit_id = that.m_unit_id;
+        if ((m_integer = that.m_integer))
+        {
+          m_value_integer = that.m_value_integer;
+        }
+        else if ((m_real = that.m_real))
+        {
+          m_value_real = that.m_value_real;
+        }
+        else if ((m_big_integer = that.m_big_integer))
+        {
+          m_value_big_integer = that.m_value_big_integer;
+        } else {
+          m_value_number = that.m_value_number;
+        }
+        m_converted_number = that.m_converted_number;
+        that.m_converted_number = nullptr;
         break;
 
       case type::vector:
@@ -203,6 +298,10 @@ namespace laskin
         break;
     }
     that.m_type = type::boolean;
+    that.m_integer = false;
+    that.m_big_integer = false;
+    that.m_real = false;
+    that.m_unit_id = unresolved_unit;
     that.m_value_boolean = false;
   }
 
@@ -236,7 +335,8 @@ namespace laskin
   {
     reset();
     m_type = type::number;
-    m_value_number = new number(value);
+    m_integer = true;
+    m_value_integer = value;
 
     return *this;
   }
@@ -246,7 +346,8 @@ namespace laskin
   {
     reset();
     m_type = type::number;
-    m_value_number = new number(value);
+    m_integer = true;
+    m_value_integer = value;
 
     return *this;
   }
@@ -261,6 +362,22 @@ namespace laskin
     return *this;
   }
 
+  value&
+  value::assign(const big_integer& value)
+  {
+    reset();
+    m_type = type::number;
+    if ((m_integer = value.fits_long()))
+    {
+      m_value_integer = value.to_long();
+    } else {
+      m_big_integer = true;
+      m_value_big_integer = new big_integer(value);
+    }
+
+    return *this;
+  }
+
   value&
   value::assign(const std::u32string& value)
   {
@@ -366,7 +483,21 @@ namespace laskin
           break;
 
         case type::number:
-          m_value_number = new number(*that.m_value_number);
+          m_unit_id = that.m_unit_id;
+          if ((m_integer = that.m_integer))
+          {
+            m_value_integer = that.m_value_integer;
+          }
+          else if ((m_real = that.m_real))
+          {
+            m_value_real = that.m_value_real;
+          }
+          else if ((m_big_integer = that.m_big_integer))
+          {
+            m_value_big_integer = new big_integer(*that.m_value_big_integer);
+          } else {
+            m_value_number = new number(*that.m_value_number);
+          }
           break;
 
         case type::vector:
@@ -419,7 +550,23 @@ namespace laskin
           break;
 
         case type::number:
-          m_value_number = that.m_value_number;
+          m_unit_id = that.m_unit_id;
+          if ((m_integer = that.m_integer))
+          {
+            m_value_integer = that.m_value_integer;
+          }
+          else if ((m_real = that.m_real))
+          {
+            m_value_real = that.m_value_real;
+          }
+          else if ((m_big_integer = that.m_big_integer))
+          {
+            m_value_big_integer = that.m_value_big_integer;
+          } else {
+            m_value_number = that.m_value_number;
+          }
+          m_converted_number = that.m_converted_number;
+          that.m_converted_number = nullptr;
           break;
 
         case type::vector:
@@ -455,12 +602,37 @@ namespace laskin
           break;
       }
       that.m_type = type::boolean;
+      that.m_integer = false;
+      that.m_big_integer = false;
+      that.m_real = false;
+      that.m_unit_id = unresolved_unit;
       that.m_value_boolean = false;
     }
 
     return *this;
   }
 
+  bool
+  value::is_real_operation(const value& that) const
+  {
+    if (!m_real && !that.m_real)
+    {
+      return false;
+    }
+
+    return (
+      m_integer ||
+      m_big_integer ||
+      m_real ||
+      !m_value_number->measurement_unit()
+    ) && (
+      that.m_integer ||
+      that.m_big_integer ||
+      that.m_real ||
+      !that.m_value_number->measurement_unit()
+    );
+  }
+
   std::u32string
   value::type_description(enum type type)
   {
@@ -506,7 +678,16 @@ namespace laskin
     switch (m_type)
     {
       case type::number:
-        delete m_value_number;
+        if (m_big_integer)
+        {
+          delete m_value_big_integer;
+        }
+        else if (!m_integer && !m_real)
+        {
+          delete m_value_number;
+        }
+        delete m_converted_number;
+        m_converted_number = nullptr;
         break;
 
       case type::vector:
@@ -538,6 +719,10 @@ namespace laskin
     }
 
     m_type = type::boolean;
+    m_integer = false;
+    m_big_integer = false;
+    m_real = false;
+    m_unit_id = unresolved_unit;
     m_value_boolean = false;
   }
 
@@ -569,10 +754,48 @@ namespace laskin
         U"; Was excepting number."
       );
     }
+    else if (m_integer || m_big_integer || m_real)
+    {
+      // The integer or double is kept as it is, so that it remains exact and
+      // further arithmetic on the value still takes the fast path.
+      if (!m_converted_number)
+      {
+        m_converted_number = m_integer
+          ? new number(m_value_integer)
+          : m_big_integer
+          ? new number(number::parse(m_value_big_integer->to_string()))
+          : new number(m_value_real);
+      }
+
+      return *m_converted_number;
+    }
 
     return *m_value_number;
   }
 
+  big_integer
+  value::to_big_integer() const
+  {
+    return m_big_integer
+      ? *m_value_big_integer
+      : big_integer(m_value_integer);
+  }
+
+  units::id
+  value::unit_id() const
+  {
+    if (m_integer || m_big_integer || m_real)
+    {
+      return units::none;
+    }
+    else if (m_unit_id == unresolved_unit)
+    {
+      m_unit_id = units::of(as_number());
+    }
+
+    return m_unit_id;
+  }
+
   const vector&
   value::as_vector() const
   {
@@ -703,6 +926,15 @@ namespace laskin
 
   value::operator long() const
   {
+    if (is_integer())
+    {
+      return m_value_integer;
+    }
+    else if (is_big_integer())
+    {
+      // Big integers are only used for integers that do not fit into long.
+      throw error(error::type::range, U"Numeric overflow.");
+    }
     try
     {
       return long(as_number());
@@ -719,6 +951,14 @@ namespace laskin
 
   value::operator double() const
   {
+    if (is_integer())
+    {
+      return static_cast<double>(m_value_integer);
+    }
+    else if (is_real())
+    {
+      return m_value_real;
+    }
     try
     {
       return double(as_number());
@@ -902,6 +1142,25 @@ namespace laskin
     return result;
   }
 
+  static std::u32string
+  number_to_string(const value& value)
+  {
+    char buffer[format::buffer_size];
+
+    if (value.is_big_integer())
+    {
+      const auto digits = value.as_big_integer().to_string();
+
+      return std::u32string(std::begin(digits), std::end(digits));
+    }
+    else if (const auto end = format::number(buffer, value))
+    {
+      return std::u32string(buffer, end);
+    }
+
+    return value.as_number().to_u32string();
+  }
+
   std::u32string
   value::to_string() const
   {
@@ -911,7 +1170,7 @@ namespace laskin
         return m_value_boolean ? U"true" : U"false";
 
       case type::number:
-        return m_value_number->to_u32string();
+        return number_to_string(*this);
 
       case type::vector:
         return vector_to_string(*m_value_vector);
@@ -996,7 +1255,7 @@ namespace laskin
         return m_value_boolean ? U"true" : U"false";
 
       case type::number:
-        return m_value_number->to_u32string();
+        return number_to_string(*this);
 
       case type::vector:
         return vector_to_source(*m_value_vector);
@@ -1041,6 +1300,17 @@ namespace laskin
   {
     using peelo::unicode::encoding::utf8::encode;
 
+    if (value.is(value::type::number))
+    {
+      char buffer[format::buffer_size];
+
+      if (const auto end = format::number(buffer, value))
+      {
+        out.write(buffer, end - buffer);
+
+        return out;
+      }
+    }
     out << encode(value.to_string());
 
     return out;
@@ -23,21 +23,170 @@
  * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
  * POSSIBILITY OF SUCH DAMAGE.
  */
+#include <cmath>
+#include <functional>
+
 #include "laskin/error.hpp"
+#include "laskin/quantities.hpp"
 #include "laskin/value.hpp"
 
 namespace laskin
 {
+  /**
+   * Reconciles measurement units of two operands into the unit of the
+   * result, and gives multipliers which convert magnitudes of the operands
+   * into that unit. Units with the same dimension are converted only when
+   * the multipliers are integers, so that the results do not differ from
+   * ones of the arbitrary precision arithmetic. When the second operand is
+   * used for scaling, it must have no unit at all.
+   */
+  static bool
+  reconcile(
+    units::id a,
+    units::id b,
+    bool scaling,
+    units::id& unit,
+    double& first,
+    double& second
+  )
+  {
+    unit = a;
+    first = second = 1.0;
+    if (scaling ? b == units::none : b == a)
+    {
+      return true;
+    }
+    else if (scaling)
+    {
+      return false;
+    }
+
+    const auto conversion = units::convert(a, b);
+
+    if (
+      !conversion ||
+      std::trunc(conversion->first) != conversion->first ||
+      std::trunc(conversion->second) != conversion->second
+    )
+    {
+      return false;
+    }
+    unit = conversion->unit;
+    first = conversion->first;
+    second = conversion->second;
+
+    return true;
+  }
+
+  /**
+   * Performs given operation on magnitudes of two vectors of quantities, if
+   * both of them can be represented densely. Units are reconciled once for
+   * the whole vector, as described above. Returns boolean flag telling
+   * whether the result was computed.
+   */
+  template<class Operation>
+  static bool
+  dense(
+    const vector& a,
+    const vector& b,
+    bool scaling,
+    Operation operation,
+    vector& result
+  )
+  {
+    auto x = quantities::extract(a);
+
+    if (!x)
+    {
+      return false;
+    }
+
+    const auto y = quantities::extract(b);
+    const auto size = x->magnitudes.size();
+    double first;
+    double second;
+
+    if (
+      !y ||
+      !reconcile(x->unit, y->unit, scaling, x->unit, first, second)
+    )
+    {
+      return false;
+    }
+    x->real = x->real || y->real;
+    for (quantities::size_type i = 0; i < size; ++i)
+    {
+      auto& magnitude = x->magnitudes[i];
+
+      magnitude = operation(magnitude * first, y->magnitudes[i] * second);
+      if (!quantities::is_exact(magnitude))
+      {
+        return false;
+      }
+    }
+    result = x->box();
+
+    return true;
+  }
+
+  /**
+   * Performs given operation between magnitudes of vector of quantities and
+   * single number, under the same conditions as above.
+   */
+  template<class Operation>
+  static bool
+  dense(
+    const vector& a,
+    const value& b,
+    bool scaling,
+    Operation operation,
+    vector& result
+  )
+  {
+    auto x = quantities::extract(a);
+    units::id unit;
+    double operand;
+    bool real;
+    double first;
+    double second;
+
+    if (
+      !x ||
+      !quantities::extract(b, unit, operand, real) ||
+      !reconcile(x->unit, unit, scaling, x->unit, first, second)
+    )
+    {
+      return false;
+    }
+    x->real = x->real || real;
+    operand *= second;
+    for (auto& magnitude : x->magnitudes)
+    {
+      magnitude = operation(magnitude * first, operand);
+      if (!quantities::is_exact(magnitude))
+      {
+        return false;
+      }
+    }
+    result = x->box();
+
+    return true;
+  }
   vector
   operator+(const vector& a, const vector& b)
   {
     const auto size = a.size();
-    vector result(a);
+    vector result;
 
     if (size != b.size())
     {
       throw error(error::type::range, U"Vector length mismatch.");
     }
+    else if (dense(a, b, false, std::plus<double>(), result))
+    {
+      return result;
+    }
+    result = a;
     for (vector::size_type i = 0; i < size; ++i)
     {
       result[i] += b[i];
@@ -52,6 +201,10 @@ namespace laskin
     const auto size = a.size();
     vector result;
 
+    if (dense(a, b, false, std::plus<double>(), result))
+    {
+      return result;
+    }
     result.reserve(size);
     for (const auto& value : a)
     {
@@ -65,12 +218,17 @@ namespace laskin
   operator-(const vector& a, const vector& b)
   {
     const auto size = a.size();
-    vector result(a);
+    vector result;
 
     if (size != b.size())
     {
       throw error(error::type::range, U"Vector length mismatch.");
     }
+    else if (dense(a, b, false, std::minus<double>(), result))
+    {
+      return result;
+    }
+    result = a;
     for (vector::size_type i = 0; i < size; ++i)
     {
       result[i] -= b[i];
@@ -85,6 +243,10 @@ namespace laskin
     const auto size = a.size();
     vector result;
 
+    if (dense(a, b, false, std::minus<double>(), result))
+    {
+      return result;
+    }
     result.reserve(size);
     for (const auto& value : a)
     {
@@ -98,12 +260,17 @@ namespace laskin
   operator*(const vector& a, const vector& b)
   {
     const auto size = a.size();
-    vector result(a);
+    vector result;
 
     if (size != b.size())
     {
       throw error(error::type::range, U"Vector length mismatch.");
     }
+    else if (dense(a, b, true, std::multiplies<double>(), result))
+    {
+      return result;
+    }
+    result = a;
     for (vector::size_type i = 0; i < size; ++i)
     {
       result[i] *= b[i];
@@ -118,6 +285,10 @@ namespace laskin
     const auto size = a.size();
     vector result;
 
+    if (dense(a, b, true, std::multiplies<double>(), result))
+    {
+      return result;
+    }
     result.reserve(size);
     for (const auto& value : a)
     {
@@ -131,12 +302,17 @@ namespace laskin
   operator/(const vector& a, const vector& b)
   {
     const auto size = a.size();
-    vector result(a);
+    vector result;
 
     if (size != b.size())
     {
       throw error(error::type::range, U"Vector length mismatch.");
     }
+    else if (dense(a, b, true, std::divides<double>(), result))
+    {
+      return result;
+    }
+    result = a;
     for (vector::size_type i = 0; i < size; ++i)
     {
       result[i] /= b[i];
@@ -151,6 +327,10 @@ namespace laskin
     const auto size = a.size();
     vector result;
 
+    if (dense(a, b, true, std::divides<double>(), result))
+    {
+      return result;
+    }
     result.reserve(size);
     for (const auto& value : a)
     {
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+#include <climits>
+#include <string>
+
+#include "laskin/big_integer.hpp"
+#include "laskin/context.hpp"
+
+using laskin::big_integer;
+using laskin::context;
+using laskin::value;
+
+static value
+evaluate(const std::u32string& source)
+{
+  context context;
+
+  context.run(source);
+  assert(context.data.size() == 1);
+
+  return context.data.back();
+}
+
+static void
+test_parse()
+{
+  big_integer result;
+
+  assert(big_integer::parse("-9223372036854775809", result));
+  assert(result.to_string() == "-9223372036854775809");
+  assert(big_integer::parse("+12", result));
+  assert(result.fits_long() && result.to_long() == 12);
+  assert(!big_integer::parse("", result));
+  assert(!big_integer::parse("-", result));
+  assert(!big_integer::parse("1e5", result));
+}
+
+static void
+test_max_plus_one()
+{
+  const auto result = evaluate(U"9223372036854775807 1 +");
+
+  assert(result.is_big_integer());
+  assert(result.to_string() == U"9223372036854775808");
+  assert(evaluate(U"9223372036854775807 1 + 1 -").is_integer());
+  assert(evaluate(U"9223372036854775807 1 + 1 -").as_integer() == LONG_MAX);
+}
+
+static void
+test_min_times_minus_one()
+{
+  const auto result = evaluate(U"-9223372036854775808 -1 *");
+
+  assert(result.is_big_integer());
+  assert(result.to_string() == U"9223372036854775808");
+  assert(evaluate(U"-9223372036854775808 1 -").to_string() ==
+    U"-9223372036854775809");
+}
+
+/**
+ * Returns program which computes factorial of given number by multiplying
+ * integer literals together.
+ */
+static std::u32string
+factorial(int n)
+{
+  std::u32string source = U"1";
+
+  for (int i = 2; i <= n; ++i)
+  {
+    const auto digits = std::to_string(i);
+
+    source += U' ';
+    source.append(std::begin(digits), std::end(digits));
+    source += U" *";
+  }
+
+  return source;
+}
+
+static void
+test_factorial()
+{
+  const auto result = evaluate(factorial(21));
+
+  assert(evaluate(factorial(20)).is_integer());
+  assert(result.is_big_integer());
+  assert(result.to_string() == U"51090942171709440000");
+  // 23! has more significant bits than double can hold.
+  assert(evaluate(factorial(23)).to_string() == U"25852016738884976640000");
+}
+
+static void
+test_exact_arithmetic()
+{
+  // 2^64 + 1 cannot be represented exactly with 53 bits of precision.
+  assert(evaluate(U"64 2 number:pow 1 +").to_string() ==
+    U"18446744073709551617");
+  assert(evaluate(U"64 2 number:pow 1 + 10 %").equals(value(7)));
+  assert(evaluate(U"64 2 number:pow 1 + 64 2 number:pow -").equals(value(1)));
+  assert(evaluate(U"18446744073709551617").is_big_integer());
+  assert(evaluate(U"18446744073709551617 18446744073709551616 >").equals(
+    value(true)
+  ));
+  assert(!evaluate(U"18446744073709551617 18446744073709551616 =").equals(
+    value(true)
+  ));
+}
+
+static void
+test_division()
+{
+  assert(!evaluate(U"9223372036854775807 1 + 2 /").is_big_integer());
+  assert(evaluate(U"9223372036854775807 1 + 2 /").equals(
+    evaluate(U"4611686018427387904")
+  ));
+}
+
+int
+main()
+{
+  test_parse();
+  test_max_plus_one();
+  test_min_times_minus_one();
+  test_factorial();
+  test_exact_arithmetic();
+  test_division();
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+
+#include "laskin/context.hpp"
+
+using laskin::context;
+using laskin::value;
+
+static void
+test_fresh_generations()
+{
+  context a;
+  context b;
+
+  assert(a.generation() != b.generation());
+  assert(a.dictionary().size() == b.dictionary().size());
+}
+
+static void
+test_define()
+{
+  context context;
+  const auto generation = context.generation();
+
+  context.define(U"foo", laskin::quote::parse(U"1 2 +"));
+  assert(context.generation() != generation);
+  assert(context.is_defined(U"foo"));
+  assert(context.dictionary().find(U"foo") != std::end(context.dictionary()));
+}
+
+static void
+test_undefine()
+{
+  context context;
+
+  context.define(U"number:foo", laskin::quote::parse(U"1 +"));
+  assert(context.resolve(U"foo", value::type::number));
+
+  const auto generation = context.generation();
+
+  assert(context.undefine(U"number:foo"));
+  assert(context.generation() != generation);
+  assert(!context.resolve(U"foo", value::type::number));
+  assert(!context.is_defined(U"number:foo"));
+}
+
+int
+main()
+{
+  test_fresh_generations();
+  test_define();
+  test_undefine();
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+
+#include "laskin/decimal.hpp"
+
+using laskin::number;
+using laskin::value;
+
+namespace decimal = laskin::decimal;
+
+/**
+ * Tests that given literal is parsed into the same number as the arbitrary
+ * precision parser would parse it into, whether it's parsed by the decimal
+ * parser or left for the arbitrary precision parser.
+ */
+static void
+expect_same(const std::u32string& input)
+{
+  value result;
+
+  assert(value::parse_number(input, result));
+  assert(number::is_valid(input));
+  assert(result.equals(value(number::parse(input))));
+}
+
+static void
+test_omitted_integer_part()
+{
+  value result;
+
+  assert(decimal::parse(U".5", result) == decimal::errc::ok);
+  assert(result.equals(value(0.5)));
+  expect_same(U".5");
+  expect_same(U"-.5");
+  assert(decimal::parse(U".", result) == decimal::errc::invalid);
+  assert(decimal::parse(U".e5", result) == decimal::errc::invalid);
+}
+
+static void
+test_plus_sign()
+{
+  value result;
+
+  assert(decimal::parse(U"+1e5", result) == decimal::errc::ok);
+  assert(result.equals(value(100000)));
+  expect_same(U"+1e5");
+  expect_same(U"+15");
+  assert(decimal::parse(U"+", result) == decimal::errc::invalid);
+}
+
+static void
+test_incomplete_exponent()
+{
+  value result;
+
+  assert(decimal::parse(U"1e", result) != decimal::errc::ok);
+  assert(value::parse_number(U"1e", result) == number::is_valid(U"1e"));
+  assert(decimal::parse(U"1e+", result) != decimal::errc::ok);
+  assert(value::parse_number(U"1e+", result) == number::is_valid(U"1e+"));
+}
+
+static void
+test_negative_zero()
+{
+  value result;
+
+  assert(decimal::parse(U"-0", result) == decimal::errc::ok);
+  assert(result.is_integer() && result.as_integer() == 0);
+  expect_same(U"-0");
+  expect_same(U"-0.0");
+}
+
+static void
+test_long_literals()
+{
+  const std::u32string fraction = U"0." + std::u32string(70, U'3');
+  const std::u32string integer = U"1" + std::u32string(70, U'0');
+  value result;
+
+  assert(decimal::parse(fraction, result) == decimal::errc::out_of_range);
+  expect_same(fraction);
+  assert(decimal::parse(integer, result) == decimal::errc::out_of_range);
+  assert(value::parse_number(integer, result));
+  assert(result.is_big_integer());
+  assert(result.to_string() == integer);
+}
+
+static void
+test_units()
+{
+  value result;
+
+  assert(decimal::parse(U"5km", result) == decimal::errc::ok);
+  expect_same(U"5km");
+  expect_same(U"1.5h");
+  assert(decimal::parse(U"5foo", result) == decimal::errc::unknown_unit);
+  assert(!value::parse_number(U"5foo", result));
+  assert(decimal::parse(U"2020-01-01", result) == decimal::errc::invalid);
+}
+
+int
+main()
+{
+  test_omitted_integer_part();
+  test_plus_sign();
+  test_incomplete_exponent();
+  test_negative_zero();
+  test_long_literals();
+  test_units();
+}
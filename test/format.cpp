@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+#include <limits>
+#include <string>
+
+#include "laskin/format.hpp"
+
+using laskin::value;
+
+static std::string
+format_real(double number)
+{
+  char buffer[laskin::format::buffer_size];
+  const auto end = laskin::format::real(buffer, number);
+
+  assert(end);
+
+  return std::string(buffer, end);
+}
+
+static void
+test_fixed_notation()
+{
+  assert(format_real(0) == "0");
+  assert(format_real(-2.5) == "-2.5");
+  assert(format_real(0.1) == "0.1");
+  assert(format_real(0.0001) == "0.0001");
+  assert(format_real(0.000001) == "0.000001");
+  assert(format_real(1000000) == "1000000");
+  assert(format_real(2000000.0 / 2) == "1000000");
+  assert(format_real(1e20) == "100000000000000000000");
+}
+
+static void
+test_scientific_notation()
+{
+  assert(format_real(1e-7) == "1e-07");
+  assert(format_real(-1e-7) == "-1e-07");
+  assert(format_real(1e21) == "1e+21");
+  assert(format_real(1.5e300) == "1.5e+300");
+}
+
+static void
+test_non_finite()
+{
+  char buffer[laskin::format::buffer_size];
+
+  assert(!laskin::format::real(
+    buffer,
+    std::numeric_limits<double>::infinity()
+  ));
+  assert(!laskin::format::real(
+    buffer,
+    std::numeric_limits<double>::quiet_NaN()
+  ));
+}
+
+static void
+test_round_trip()
+{
+  static const double numbers[] =
+  {
+    0.1 + 0.2,
+    1.0 / 3,
+    -2.0 / 3,
+    123456.789,
+    0.000001,
+    0.0000012345678901234567,
+    9.999999999999999e20,
+    1e21,
+    1e-7,
+    std::numeric_limits<double>::min(),
+    std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::denorm_min(),
+  };
+
+  for (const auto number : numbers)
+  {
+    const auto source = format_real(number);
+    const auto parsed = value::parse_number(
+      std::u32string(std::begin(source), std::end(source))
+    );
+
+    assert(source.length() < laskin::format::buffer_size);
+    assert(static_cast<double>(parsed) == number);
+  }
+}
+
+int
+main()
+{
+  test_fixed_notation();
+  test_scientific_notation();
+  test_non_finite();
+  test_round_trip();
+}
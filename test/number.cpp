@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+#include <optional>
+
+#include "laskin/context.hpp"
+#include "laskin/error.hpp"
+
+using laskin::context;
+using laskin::error;
+
+using laskin::numeric;
+
+/**
+ * Evaluates given program and returns source code representation of the
+ * value it leaves on top of the stack, or nothing if it fails.
+ */
+static std::optional<std::u32string>
+evaluate(const std::u32string& source, enum numeric::mode mode)
+{
+  context context;
+
+  context.numeric.set_mode(mode);
+  try
+  {
+    context.run(source);
+  }
+  catch (const error&)
+  {
+    return std::nullopt;
+  }
+  assert(context.data.size() == 1);
+
+  return context.data.back().to_source();
+}
+
+/**
+ * Tests that broadcasting math word over vector gives the same results as
+ * mapping the corresponding scalar word over it, in both numeric modes.
+ */
+static void
+expect_same(
+  const std::u32string& operands,
+  const std::u32string& vector_word,
+  const std::u32string& map_quote,
+  const std::u32string& elements
+)
+{
+  static const enum numeric::mode modes[] =
+  {
+    numeric::mode::mpfr,
+    numeric::mode::fast,
+  };
+
+  for (const auto mode : modes)
+  {
+    assert(
+      evaluate(operands + U" " + elements + U" " + vector_word, mode) ==
+      evaluate(map_quote + U" " + elements + U" vector:map", mode)
+    );
+  }
+}
+
+static const char32_t* inputs[] =
+{
+  U"[0.25, 0.5, 0.75]",
+  U"[1, 2, 3]",
+  U"[1, 2.5, -3]",
+  U"[]",
+  U"[1, \"a\"]",
+};
+
+static void
+test_unary()
+{
+  static const char32_t* words[] =
+  {
+    U"ceil", U"floor", U"round",
+    U"exp", U"exp2", U"expm1",
+    U"log", U"log10", U"log2", U"log1p",
+    U"sqrt", U"cbrt",
+    U"acos", U"asin", U"atan",
+    U"cos", U"sin", U"tan",
+    U"deg", U"rad",
+    U"sinh", U"cosh", U"tanh",
+    U"asinh", U"acosh", U"atanh",
+  };
+
+  for (const std::u32string word : words)
+  {
+    for (const auto input : inputs)
+    {
+      expect_same(
+        U"",
+        U"vector:" + word,
+        U"( number:" + word + U" )",
+        input
+      );
+    }
+  }
+  expect_same(U"", U"vector:round", U"( number:round )", U"[1.5km, 2.25km]");
+}
+
+static void
+test_binary()
+{
+  static const char32_t* words[] = { U"pow", U"hypot", U"atan2" };
+  static const char32_t* operands[] = { U"2", U"0.5", U"100" };
+
+  for (const std::u32string word : words)
+  {
+    for (const std::u32string operand : operands)
+    {
+      for (const auto input : inputs)
+      {
+        expect_same(
+          operand,
+          U"vector:" + word,
+          U"( " + operand + U" swap number:" + word + U" )",
+          input
+        );
+      }
+    }
+  }
+}
+
+static void
+test_clamp()
+{
+  for (const auto input : inputs)
+  {
+    expect_same(
+      U"0.5 2",
+      U"vector:clamp",
+      U"( 0.5 2 rot number:clamp )",
+      input
+    );
+  }
+  expect_same(U"1km 2km", U"vector:clamp", U"( 1km 2km rot number:clamp )",
+    U"[500m, 1.5km, 3km]");
+}
+
+int
+main()
+{
+  test_unary();
+  test_binary();
+  test_clamp();
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
+#include "laskin/context.hpp"
+#include "laskin/error.hpp"
+#include "laskin/optimizer.hpp"
+#include "laskin/profiler.hpp"
+
+using laskin::context;
+using laskin::error;
+using laskin::quote;
+
+namespace optimizer = laskin::optimizer;
+
+/**
+ * Stack contents, output and error type, if any, of an executed program.
+ */
+struct outcome
+{
+  context::container_type data;
+  std::string output;
+  std::optional<enum error::type> error_type;
+};
+
+/**
+ * Executes given program either optimized or as it was written. Programs
+ * are executed without optimizations when the context has an profiler.
+ */
+static outcome
+execute(const std::u32string& source, bool optimized)
+{
+  context context;
+  std::ostringstream out;
+  outcome result;
+
+  if (!optimized)
+  {
+    context.profiler = std::make_shared<laskin::profiler>();
+  }
+  try
+  {
+    context.run(source, &out);
+  }
+  catch (const error& e)
+  {
+    result.error_type = e.type;
+  }
+  result.data = context.data;
+  result.output = out.str();
+
+  return result;
+}
+
+/**
+ * Tests that the optimized program behaves just like the original one.
+ * Contents of the stack are not compared when the program fails, as it's
+ * not specified what an failing word leaves into the stack.
+ */
+static void
+expect_same(const std::u32string& source)
+{
+  const auto optimized = execute(source, true);
+  const auto original = execute(source, false);
+
+  assert(optimized.error_type == original.error_type);
+  assert(optimized.output == original.output);
+  assert(original.error_type || optimized.data == original.data);
+}
+
+/**
+ * Tests whether given program is compiled into node of given type.
+ */
+template<class T>
+static bool
+compiles_into(const std::u32string& source)
+{
+  const auto nodes = quote::parse(source).compiled();
+
+  return std::any_of(
+    std::begin(*nodes),
+    std::end(*nodes),
+    [](const auto& node)
+    {
+      return !!std::dynamic_pointer_cast<const T>(node);
+    }
+  );
+}
+
+static void
+test_constant_folding()
+{
+  assert(compiles_into<optimizer::folded>(U"60 60 *"));
+  assert(compiles_into<optimizer::folded>(U"\"a\" \"b\" +"));
+  expect_same(U"60 60 *");
+  expect_same(U"[1, 2, 3] vector:sum");
+  expect_same(U"\"a\" \"b\" +");
+  expect_same(U"1 2 + 3 * 4 -");
+  expect_same(U"1 0 /");
+  expect_same(U"\"a\" 1 +");
+}
+
+static void
+test_redefined_constant_folding()
+{
+  const auto source = U"( drop drop 42 ) \"+\" define 1 2 +";
+
+  expect_same(source);
+  assert(execute(source, true).data.back().equals(laskin::value(42)));
+}
+
+static void
+test_no_op_elimination()
+{
+  const auto nodes = quote::parse(U"dup drop").compiled();
+  const auto folded = std::dynamic_pointer_cast<const optimizer::folded>(
+    nodes->front()
+  );
+
+  assert(nodes->size() == 1);
+  assert(folded && folded->values.empty() && folded->depth == 1);
+  expect_same(U"1 dup drop");
+  expect_same(U"1 2 swap swap");
+  expect_same(U"1 2 over drop");
+  expect_same(U"dup drop");
+  expect_same(U"1 swap swap");
+}
+
+static void
+test_branch_lowering()
+{
+  assert(compiles_into<optimizer::branch>(U"true ( 1 ) if"));
+  assert(compiles_into<optimizer::branch>(U"1 2 < ( 1 ) ( 2 ) if-else"));
+  expect_same(U"true ( 1 ) if");
+  expect_same(U"false ( 1 ) if");
+  expect_same(U"1 2 < ( \"yes\" . ) ( \"no\" . ) if-else");
+  expect_same(U"2 1 < ( \"yes\" . ) ( \"no\" . ) if-else");
+  expect_same(U"1 ( 1 ) if");
+  expect_same(U"( 1 ) if");
+  expect_same(U"( drop drop \"x\" ) \"if\" define true ( 1 ) if");
+}
+
+static void
+test_loop_lowering()
+{
+  assert(compiles_into<optimizer::loop>(U"0 ( dup 5 < ) ( 1 + ) while"));
+  expect_same(U"0 ( dup 5 < ) ( dup . 1 + ) while");
+  expect_same(U"0 ( false ) ( 1 + ) while");
+  expect_same(U"0 ( 1 ) ( 1 + ) while");
+}
+
+static void
+test_repeat_lowering()
+{
+  assert(compiles_into<optimizer::repeat>(U"0 ( 1 + ) 5 number:times"));
+  expect_same(U"0 ( 1 + ) 5 number:times");
+  expect_same(U"( \"a\" . ) 3 number:times");
+  expect_same(U"0 ( 1 + ) 0 number:times");
+  expect_same(U"0 ( 1 + ) -1 number:times");
+  expect_same(U"( 1 ) \"number:times\" define 0 ( 1 + ) 5 number:times");
+}
+
+/**
+ * Constructs program which applies given words into given input. The words
+ * are placed into an word definition, so that the input is not known when
+ * they are compiled and cannot be folded into constants.
+ */
+static std::u32string
+apply(const std::u32string& input, const std::u32string& words)
+{
+  return U"( " + words + U" ) \"f\" define " + input + U" f";
+}
+
+static void
+test_superinstructions()
+{
+  static const char32_t* sequences[] =
+  {
+    U"dup 1 -",
+    U"dup .",
+    U"swap drop",
+    U"over over",
+    U"0 <>",
+    U"1 +",
+    U"1 -",
+  };
+  static const char32_t* inputs[] =
+  {
+    U"",
+    U"5",
+    U"1.5",
+    U"4 0",
+    U"5km",
+    U"\"a\" \"b\"",
+    U"9223372036854775807",
+    U"-9223372036854775808",
+    U"9223372036854775808",
+  };
+
+  for (const auto sequence : sequences)
+  {
+    assert(compiles_into<optimizer::fused>(sequence));
+    for (const auto input : inputs)
+    {
+      expect_same(apply(input, sequence));
+    }
+  }
+  expect_same(apply(U"5", U"( 2 ) \"1\" define 1 +"));
+}
+
+static void
+test_pipeline_fusion()
+{
+  static const char32_t* pipelines[] =
+  {
+    U"( 2 * ) [1, 2, 3, 4] vector:map ( 4 > ) swap vector:filter",
+    U"( 2 * ) [1, 2, 3, 4] vector:map ( 4 > ) swap vector:filter "
+    U"( + ) swap vector:reduce",
+    U"( 0 > ) [-1, 2, -3, 4] vector:filter ( 3 * ) swap vector:map",
+    U"( 1.5 * ) [1, 2, 3] vector:map vector:sum",
+    U"( 2 * ) [1, 2, 3] vector:map ( 10 > ) swap vector:filter "
+    U"( + ) swap vector:reduce",
+    U"( 2 * ) [] vector:map ( + ) swap vector:reduce",
+    U"( 2 * ) [1, \"a\", 3] vector:map ( 1 > ) swap vector:filter",
+    U"( 1 ) [1, 2] vector:map ( 1 + ) swap vector:filter",
+    U"( 2 * ) [1km, 2km] vector:map ( 3km > ) swap vector:filter",
+  };
+
+  assert(compiles_into<optimizer::pipeline>(pipelines[0]));
+  assert(compiles_into<optimizer::pipeline>(pipelines[1]));
+  for (const auto pipeline : pipelines)
+  {
+    expect_same(pipeline);
+  }
+  // Side effects must not be interleaved.
+  expect_same(
+    U"( dup . ) [1, 2, 3] vector:map ( dup . 1 > ) swap vector:filter"
+  );
+  expect_same(
+    U"( drop drop [] ) \"vector:filter\" define "
+    U"( 2 * ) [1, 2, 3] vector:map ( 1 > ) swap vector:filter"
+  );
+}
+
+int
+main()
+{
+  test_constant_folding();
+  test_redefined_constant_folding();
+  test_no_op_elimination();
+  test_branch_lowering();
+  test_loop_lowering();
+  test_repeat_lowering();
+  test_superinstructions();
+  test_pipeline_fusion();
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+
+#include "laskin/context.hpp"
+#include "laskin/error.hpp"
+#include "laskin/parse_cache.hpp"
+
+using laskin::context;
+using laskin::parse_cache;
+using laskin::quote;
+
+/**
+ * Evaluates given program with or without parse cache and returns the
+ * resulting stack.
+ */
+static context::container_type
+evaluate(
+  const std::u32string& source,
+  const std::shared_ptr<parse_cache>& cache
+)
+{
+  context context;
+
+  context.parse_cache = cache;
+  context.run(source);
+
+  return context.data;
+}
+
+static void
+test_hits_and_misses()
+{
+  parse_cache cache;
+  const auto first = cache.parse(U"1 2 +");
+  const auto second = cache.parse(U"1 2 +");
+
+  assert(cache.hits() == 1);
+  assert(cache.misses() == 1);
+  assert(first.equals(second));
+  assert(first.equals(quote::parse(U"1 2 +")));
+  cache.parse(U"1 2 -");
+  assert(cache.misses() == 2);
+  cache.clear();
+  assert(cache.hits() == 0 && cache.misses() == 0);
+}
+
+static void
+test_least_recently_used_is_discarded()
+{
+  parse_cache cache(2);
+
+  cache.parse(U"a");
+  cache.parse(U"b");
+  cache.parse(U"a");
+  cache.parse(U"c");
+  assert(cache.hits() == 1);
+  cache.parse(U"a");
+  assert(cache.hits() == 2);
+  cache.parse(U"b");
+  assert(cache.misses() == 4);
+}
+
+static void
+test_resize()
+{
+  parse_cache cache(2);
+
+  cache.parse(U"a");
+  cache.parse(U"b");
+  cache.resize(1);
+  assert(cache.capacity() == 1);
+  cache.parse(U"b");
+  cache.parse(U"a");
+  assert(cache.hits() == 1);
+  assert(cache.misses() == 3);
+  cache.resize(0);
+  cache.parse(U"a");
+  cache.parse(U"a");
+  assert(cache.hits() == 1);
+  assert(cache.misses() == 5);
+}
+
+static void
+test_syntax_errors_are_not_cached()
+{
+  parse_cache cache;
+
+  for (int i = 0; i < 2; ++i)
+  {
+    try
+    {
+      cache.parse(U"( 1");
+      assert(false);
+    }
+    catch (const laskin::error& e)
+    {
+      assert(e.type == laskin::error::type::syntax);
+    }
+  }
+  assert(cache.hits() == 0);
+  assert(cache.misses() == 2);
+}
+
+static void
+test_string_to_quote()
+{
+  const auto source = U"( \"1 2 +\" string:>quote quote:call ) 3 number:times";
+  const auto cache = std::make_shared<parse_cache>();
+
+  assert(evaluate(source, cache) == evaluate(source, nullptr));
+  assert(cache->hits() == 2);
+  assert(cache->misses() == 1);
+}
+
+int
+main()
+{
+  test_hits_and_misses();
+  test_least_recently_used_is_discarded();
+  test_resize();
+  test_syntax_errors_are_not_cached();
+  test_string_to_quote();
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include "laskin/context.hpp"
+#include "laskin/error.hpp"
+#include "laskin/quantities.hpp"
+
+using laskin::context;
+using laskin::quantities;
+using laskin::value;
+
+namespace units = laskin::units;
+
+static value
+evaluate(const std::u32string& source)
+{
+  context context;
+
+  context.run(source);
+  assert(context.data.size() == 1);
+
+  return context.data.back();
+}
+
+/**
+ * Tests that vector operation gives the same results as performing it
+ * separately on each element.
+ */
+template<class Operation>
+static void
+expect_elementwise(
+  const std::u32string& a,
+  const std::u32string& b,
+  Operation operation
+)
+{
+  const auto x = evaluate(a).as_vector();
+  const auto y = evaluate(b);
+  const auto result = operation(value(x), y).as_vector();
+
+  assert(result.size() == x.size());
+  for (laskin::vector::size_type i = 0; i < x.size(); ++i)
+  {
+    const auto expected = operation(
+      x[i],
+      y.is(value::type::vector) ? y.as_vector()[i] : y
+    );
+
+    assert(result[i].equals(expected));
+    assert(result[i].unit_id() == expected.unit_id());
+  }
+}
+
+static void
+test_extract()
+{
+  const auto elements = evaluate(U"[10km, 12km, 9km]").as_vector();
+  const auto dense = quantities::extract(elements);
+
+  assert(dense);
+  assert(dense->unit == units::find(U"km"));
+  assert(dense->magnitudes.size() == 3);
+  assert(dense->magnitudes[1] == 12.0);
+  assert(!quantities::extract(evaluate(U"[10km, 12m]").as_vector()));
+  assert(!quantities::extract(evaluate(U"[1, 2, 3]").as_vector()));
+  assert(quantities::extract(evaluate(U"[1, 2, 3]").as_vector(), true));
+}
+
+static void
+test_arithmetic()
+{
+  const auto add = [](const value& a, const value& b) { return a + b; };
+  const auto substract = [](const value& a, const value& b) { return a - b; };
+  const auto multiply = [](const value& a, const value& b) { return a * b; };
+  const auto divide = [](const value& a, const value& b) { return a / b; };
+
+  expect_elementwise(U"[10km, 12km, 9km]", U"[1km, 2km, 3km]", add);
+  expect_elementwise(U"[10km, 12km, 9km]", U"[1km, 2km, 3km]", substract);
+  expect_elementwise(U"[10km, 12km, 9km]", U"2km", add);
+  expect_elementwise(U"[10km, 12km, 9km]", U"2", multiply);
+  expect_elementwise(U"[10km, 12km, 9km]", U"4", divide);
+  expect_elementwise(U"[10km, 12m, 9km]", U"[1km, 2km, 3km]", add);
+  expect_elementwise(U"[1.5, 2.5]", U"[0.25, 0.5]", multiply);
+  expect_elementwise(U"[10m, 12m]", U"[1km, 2km]", add);
+}
+
+static void
+test_unit_mismatch()
+{
+  context context;
+
+  try
+  {
+    context.run(U"[10km, 12km] [1kg, 2kg] +");
+    assert(false);
+  }
+  catch (const laskin::error& e)
+  {
+    assert(e.type == laskin::error::type::unit);
+  }
+}
+
+static void
+test_sum()
+{
+  const auto result = evaluate(U"[10km, 12km, 9km] vector:sum");
+
+  assert(result.equals(evaluate(U"10km 12km + 9km +")));
+  assert(result.unit_id() == units::find(U"km"));
+  assert(evaluate(U"[1.5, 2.5, 3] vector:sum").equals(value(7)));
+}
+
+static void
+test_compensated_sum()
+{
+  quantities dense;
+
+  dense.magnitudes = { 1e16, 1.0, -1e16 };
+  assert(dense.sum() == 1.0);
+
+  dense.magnitudes.assign(10, 0.1);
+  assert(dense.sum() == 1.0);
+}
+
+/**
+ * Tests that sums of vectors around the size where the summation is split
+ * into multiple threads are exact when the exact result can be represented,
+ * and that the result does not change between runs.
+ */
+static void
+test_parallel_sum()
+{
+  const quantities::size_type split = 1 << 18;
+
+  for (const auto size : { split - 1, split, split + 1, 4 * split + 3 })
+  {
+    quantities dense;
+    std::uint64_t state = 88172645463325252ULL;
+    double expected;
+    double first;
+    long double reference;
+
+    dense.magnitudes.resize(size);
+    for (quantities::size_type i = 0; i < size; ++i)
+    {
+      dense.magnitudes[i] = i + 0.5;
+    }
+    expected = static_cast<double>(size) * size / 2;
+    assert(dense.sum() == expected);
+
+    // Pseudo random magnitudes with varying exponents.
+    for (auto& magnitude : dense.magnitudes)
+    {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      magnitude = std::ldexp(
+        static_cast<double>(state >> 11),
+        static_cast<int>(state % 40) - 73
+      );
+    }
+    first = dense.sum();
+    reference = 0.0L;
+    for (const auto magnitude : dense.magnitudes)
+    {
+      reference += magnitude;
+    }
+    assert(std::fabs(first - reference) <= std::fabs(reference) * 1e-15L);
+    for (int i = 0; i < 4; ++i)
+    {
+      assert(dense.sum() == first);
+    }
+  }
+}
+
+static void
+test_vector_sum()
+{
+  assert(evaluate(
+    U"( 0.5 + ) 0 262145 number:range vector:map vector:sum"
+  ).equals(evaluate(U"262145 262145 * 2 /")));
+}
+
+int
+main()
+{
+  test_extract();
+  test_arithmetic();
+  test_unit_mismatch();
+  test_sum();
+  test_compensated_sum();
+  test_parallel_sum();
+  test_vector_sum();
+}
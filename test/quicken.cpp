@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+
+#include "laskin/context.hpp"
+#include "laskin/quicken.hpp"
+
+using laskin::context;
+using laskin::quicken::kernel;
+using laskin::quote;
+using laskin::value;
+
+static value
+evaluate(
+  const std::u32string& source,
+  enum laskin::numeric::mode mode = laskin::numeric::mode::mpfr
+)
+{
+  context context;
+
+  context.numeric.set_mode(mode);
+  context.run(source);
+  assert(context.data.size() == 1);
+
+  return context.data.back();
+}
+
+static void
+test_number_operand()
+{
+  context context;
+  const auto quote = quote::parse(U"2 *");
+  const auto kernel = kernel::match(quote, context, value(3));
+
+  assert(!!kernel);
+  assert(!!kernel->operand());
+  assert(kernel->operand()->equals(value(2)));
+  assert((*kernel)(context, nullptr, value(3)).equals(value(6)));
+  assert(context.data.empty());
+}
+
+static void
+test_comparison_operand()
+{
+  context context;
+  const auto quote = quote::parse(U"0 >");
+  const auto kernel = kernel::match(quote, context, value(1));
+
+  assert(!!kernel);
+  assert(kernel->operand()->equals(value(0)));
+  assert((*kernel)(context, nullptr, value(1)).equals(value(true)));
+  assert((*kernel)(context, nullptr, value(-1)).equals(value(false)));
+  assert(context.data.empty());
+}
+
+static void
+test_redefined_number_operand()
+{
+  context context;
+
+  context.run(U"( 5 ) \"2\" define");
+  assert(!kernel::match(quote::parse(U"2 *"), context, value(3)));
+}
+
+static void
+test_map()
+{
+  assert(
+    evaluate(U"( 2 * ) [1, 2, 3] vector:map").equals(
+      evaluate(U"( dup drop 2 * ) [1, 2, 3] vector:map")
+    )
+  );
+  assert(
+    evaluate(U"( 2 * ) [1, 2, 3] vector:map").equals(
+      evaluate(U"[2, 4, 6]")
+    )
+  );
+}
+
+static void
+test_filter()
+{
+  assert(
+    evaluate(U"( 0 > ) [-1, 0, 1, 2] vector:filter").equals(
+      evaluate(U"( dup drop 0 > ) [-1, 0, 1, 2] vector:filter")
+    )
+  );
+  assert(
+    evaluate(U"( 0 > ) [-1, 0, 1, 2] vector:filter").equals(
+      evaluate(U"[1, 2]")
+    )
+  );
+}
+
+static void
+test_redefined_number_in_map()
+{
+  assert(
+    evaluate(U"( 5 ) \"2\" define ( 2 * ) [1, 2, 3] vector:map").equals(
+      evaluate(U"[5, 10, 15]")
+    )
+  );
+}
+
+/**
+ * Tests whether the two numbers are equal and stored in the same way.
+ */
+static bool
+is_identical(const value& a, const value& b)
+{
+  return a.equals(b)
+    && a.is_integer() == b.is_integer()
+    && a.is_real() == b.is_real();
+}
+
+static void
+test_fast_mode()
+{
+  const auto mode = laskin::numeric::mode::fast;
+  const auto reduced = evaluate(
+    U"( + ) 1 5 number:range vector:reduce",
+    mode
+  );
+  const auto mapped = evaluate(
+    U"( 3 / ) 1 5 number:range vector:map",
+    mode
+  ).as_vector();
+  const auto interpreted = evaluate(
+    U"( dup drop 3 / ) 1 5 number:range vector:map",
+    mode
+  ).as_vector();
+
+  assert(is_identical(
+    reduced,
+    evaluate(U"( dup drop + ) 1 5 number:range vector:reduce", mode)
+  ));
+  assert(reduced.is_real());
+  assert(mapped.size() == interpreted.size());
+  for (std::size_t i = 0; i < mapped.size(); ++i)
+  {
+    assert(is_identical(mapped[i], interpreted[i]));
+    assert(mapped[i].is_real());
+  }
+}
+
+int
+main()
+{
+  test_number_operand();
+  test_comparison_operand();
+  test_redefined_number_operand();
+  test_map();
+  test_filter();
+  test_redefined_number_in_map();
+  test_fast_mode();
+}
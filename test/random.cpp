@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+#include <set>
+
+#include "laskin/context.hpp"
+#include "laskin/error.hpp"
+
+using laskin::context;
+using laskin::random_generator;
+using laskin::value;
+using laskin::vector;
+
+static vector
+evaluate(class context& context, const std::u32string& source)
+{
+  context.run(source);
+  assert(context.data.size() == 1);
+
+  return context.pop().as_vector();
+}
+
+static bool
+throws_range_error(const std::u32string& source)
+{
+  context context;
+
+  try
+  {
+    context.run(source);
+  }
+  catch (const laskin::error& e)
+  {
+    return e.type == laskin::error::type::range;
+  }
+
+  return false;
+}
+
+static void
+test_seed()
+{
+  context a;
+  context b;
+  const auto source = U"42 random:seed 100 random:vector";
+  const auto x = evaluate(a, source);
+  const auto y = evaluate(b, source);
+
+  assert(x.size() == 100);
+  assert(x == y);
+  assert(!(evaluate(a, U"43 random:seed 100 random:vector") == x));
+}
+
+static void
+test_seed_must_be_integer()
+{
+  assert(throws_range_error(U"1.5 random:seed"));
+  assert(throws_range_error(U"1m random:seed"));
+  assert(!throws_range_error(U"4 2 / random:seed"));
+}
+
+static void
+test_vector_matches_single_numbers()
+{
+  context a;
+  context b;
+  const auto x = evaluate(a, U"7 random:seed 3 random:vector");
+  const auto y = evaluate(
+    b,
+    U"7 random:seed ( drop random:number ) 0 3 number:range vector:map"
+  );
+
+  assert(x == y);
+  for (const auto& element : x)
+  {
+    const auto number = static_cast<double>(element);
+
+    assert(number >= 0.0 && number < 1.0);
+  }
+}
+
+static void
+test_jump()
+{
+  random_generator original;
+  std::set<std::uint64_t> seen;
+
+  original.seed(1);
+
+  auto jumped = original;
+
+  jumped.jump();
+  for (int i = 0; i < 1000; ++i)
+  {
+    seen.insert(original.next());
+  }
+  for (int i = 0; i < 1000; ++i)
+  {
+    assert(seen.find(jumped.next()) == std::end(seen));
+  }
+}
+
+static void
+test_integer_bounds()
+{
+  context context;
+  const auto result = evaluate(
+    context,
+    U"1 random:seed ( drop -2 3 random:integer ) 1 1000 number:range vector:map"
+  );
+  std::set<long> seen;
+
+  for (const auto& element : result)
+  {
+    const auto number = long(element);
+
+    assert(number >= -2 && number <= 3);
+    seen.insert(number);
+  }
+  assert(seen.size() == 6);
+  assert(throws_range_error(U"3 2 random:integer"));
+}
+
+static void
+test_sample_bounds()
+{
+  context context;
+  const auto result = evaluate(
+    context,
+    U"1 random:seed 3 [1, 2, 3, 4, 5] random:sample"
+  );
+  std::set<long> seen;
+
+  assert(result.size() == 3);
+  for (const auto& element : result)
+  {
+    const auto number = long(element);
+
+    assert(number >= 1 && number <= 5);
+    seen.insert(number);
+  }
+  assert(seen.size() == 3);
+  assert(evaluate(context, U"0 [1, 2] random:sample").empty());
+  assert(evaluate(context, U"2 [1, 2] random:sample").size() == 2);
+  assert(throws_range_error(U"3 [1, 2] random:sample"));
+  assert(throws_range_error(U"-1 [1, 2] random:sample"));
+}
+
+int
+main()
+{
+  test_seed();
+  test_seed_must_be_integer();
+  test_vector_matches_single_numbers();
+  test_jump();
+  test_integer_bounds();
+  test_sample_bounds();
+}
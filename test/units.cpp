@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2018-2026, Rauli Laine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <cassert>
+#include <thread>
+
+#include "laskin/context.hpp"
+#include "laskin/units.hpp"
+
+using laskin::context;
+using laskin::value;
+
+namespace units = laskin::units;
+
+static value
+evaluate(const std::u32string& source)
+{
+  context context;
+
+  context.run(source);
+  assert(context.data.size() == 1);
+
+  return context.data.back();
+}
+
+static void
+test_fixed_ids()
+{
+  assert(units::find(U"s") == units::second);
+  assert(units::find(U"min") == units::minute);
+  assert(units::find(U"h") == units::hour);
+  assert(units::find(U"d") == units::day);
+  assert(units::find(U"foo") == units::none);
+}
+
+static void
+test_ids_shared_between_threads()
+{
+  const auto id = units::find(U"km");
+  units::id other = units::none;
+  units::id fresh = units::none;
+
+  std::thread([&]()
+  {
+    other = units::find(U"km");
+    fresh = units::find(U"kg");
+  }).join();
+  assert(id != units::none);
+  assert(other == id);
+  assert(units::find(U"kg") == fresh);
+  assert(units::of(evaluate(U"2kg").as_number()) == fresh);
+}
+
+static void
+test_dimension()
+{
+  const auto dimension = units::dimension(units::find(U"km"));
+
+  assert(!units::dimension(units::none));
+  assert(dimension);
+  assert(*dimension == units::dimension(units::find(U"m")));
+  assert(*dimension != units::dimension(units::find(U"kg")));
+}
+
+static void
+test_convert()
+{
+  const auto km = units::find(U"km");
+  const auto m = units::find(U"m");
+  const auto conversion = units::convert(m, km);
+
+  assert(conversion);
+  assert(conversion->unit == m);
+  assert(conversion->first == 1.0);
+  assert(conversion->second == 1000.0);
+  assert(!units::convert(m, units::find(U"kg")));
+  assert(!units::convert(m, units::none));
+}
+
+static void
+test_mixed_unit_vector_arithmetic()
+{
+  const auto result = evaluate(U"[1.5m, 2m] [1km, 0.5km] +").as_vector();
+  const auto scalar = evaluate(U"[1.5m, 2m] 1km -").as_vector();
+
+  assert(result.size() == 2);
+  assert(result[0].equals(evaluate(U"1.5m 1km +")));
+  assert(result[1].equals(evaluate(U"2m 0.5km +")));
+  assert(result[0].unit_id() == units::find(U"m"));
+  assert(scalar.size() == 2);
+  assert(scalar[0].equals(evaluate(U"1.5m 1km -")));
+  assert(scalar[1].equals(evaluate(U"2m 1km -")));
+}
+
+int
+main()
+{
+  test_fixed_ids();
+  test_ids_shared_between_threads();
+  test_dimension();
+  test_convert();
+  test_mixed_unit_vector_arithmetic();
+}